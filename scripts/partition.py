@@ -0,0 +1,104 @@
+#!/usr/bin/python
+
+#
+#  This script splits the hosts of OpenPublicNetwork between the processes of a parallel simulation
+#    based on where the actors of a scheduled graph run, and saves the assignment as an ini file with
+#    a "partitioned" config that extends the "parallel" config of sim-models/random-graphs/omnetpp.ini,
+#    run-parallel.sh generates it before starting the processes
+#
+#  - hosts are balanced by the events their actors generate per iteration (firing, sending or
+#    receiving each token through the host's stack and forwarding it through the host's cloud),
+#    heaviest first onto the least loaded process
+#  - every process gets its own InternetCloud for its hosts ("internet" for partition 0, cloud[p-1]
+#    for partition p), so tokens between hosts of one process never leave it
+#  - hosts without actors and the configurator, which only acts at initialization, stay in partition 0
+#  - lookahead comes from the links between clouds, their delay is set to half of the smallest delay
+#    offset ("loc") in the network description, or to the given minimum if that is larger; the cloud
+#    delayer takes it off the delay of the packets that cross those links
+#
+
+import	sys
+import	json
+
+defaultFN = '../sim-models/random-graphs/partitions.ini'
+minAccessDelay = 0.1	# ms, used when every link of the network has a zero delay offset
+
+def	hostLoads(graphDesc):
+	# firing, and per token end the host's stack plus a hop through its cloud
+	load = {}
+	actor2host = {}
+
+	for actor in graphDesc['actors']:
+		actor2host[actor['name']] = actor['host']
+		load[actor['host']] = load.get(actor['host'],0) + 2
+
+	for channel in graphDesc['channels']:
+		for end in ['source','target']:
+			if end in channel and channel[end] in actor2host:
+				host = actor2host[channel[end]]
+				load[host] += 6
+
+	return load
+
+def	partition(load,numParts):
+	parts = [0.0]*numParts
+	assignment = {}
+
+	for host in sorted(load, key=lambda h: (-load[h],h)):
+		p = parts.index(min(parts))
+		parts[p] += load[host]
+		assignment[host] = p
+
+	return assignment, parts
+
+def	hostCount(networkDesc):
+	hosts = set(networkDesc) | set([dst for src in networkDesc for dst in networkDesc[src]])
+	return max([int(h[1:]) for h in hosts])+1
+
+def	lookahead(networkDesc):
+	minLoc = min([link['loc'] for src in networkDesc for link in networkDesc[src].values()])
+	return max(minLoc/2.0, minAccessDelay)
+
+def	saveIni(assignment,numParts,numHosts,delay,fn):
+	with open(fn,'w') as fh:
+		fh.write('# generated by scripts/partition.py, do not edit\n')
+		fh.write('include omnetpp.ini\n\n')
+		fh.write('[Config partitioned]\n')
+		fh.write('extends = parallel\n')
+		fh.write('parsim-num-partitions = %d\n' % numParts)
+		fh.write('*.numClouds = %d\n' % numParts)
+		fh.write('*.hostClouds = "%s"\n' % ' '.join([str(assignment.get('h%d' % i,0)) for i in range(numHosts)]))
+		fh.write('*.cloudDelay = %gms\n' % delay)
+		fh.write('**.delayer.lookahead = %gms\n' % delay)
+		for host in sorted(assignment, key=lambda h: int(h[1:])):
+			fh.write('*.h[%d]**.partition-id = %d\n' % (int(host[1:]),assignment[host]))
+		fh.write('*.h[*]**.partition-id = 0\n')
+		fh.write('*.internet**.partition-id = 0\n')
+		for p in range(1,numParts):
+			fh.write('*.cloud[%d]**.partition-id = %d\n' % (p-1,p))
+		fh.write('*.configurator.partition-id = 0\n')
+
+
+if __name__ == "__main__":
+
+	if len(sys.argv) < 4 or len(sys.argv) > 5:
+		print('usage: ' + sys.argv[0] + ' [TRADF graph] [network description] [number of processes] ([output ini])')
+		exit(1)
+
+	path2net = sys.argv[2]
+	numParts = int(sys.argv[3])
+	outFN = sys.argv[4] if len(sys.argv) == 5 else defaultFN
+
+	with open(sys.argv[1]) as fh:
+		graphDesc = json.load(fh)
+
+	with open(path2net) as fh:
+		networkDesc = json.load(fh)
+
+	assignment, parts = partition(hostLoads(graphDesc),numParts)
+	delay = lookahead(networkDesc)
+
+	saveIni(assignment,numParts,hostCount(networkDesc),delay,outFN)
+
+	print('events per iteration and process: ' + str(parts))
+	print('cloud link delay (lookahead): ' + str(delay) + 'ms')
@@ -25,7 +25,7 @@ Define_Module(FCLayer1);
 void    FCLayer1::sendVal()
 {
         nnPacket *msg = new nnPacket("token");
-        msg->setByteLength(sizeof(nnData)+sizeof(uint));
+        msg->setByteLength((quantized? sizeof(partialIn2.quant) : 0)+(doubleSums? sizeof(partialIn2.array) : 0)+sizeof(uint));
         msg->setSequenceNumber(iterCnt);
         msg->setPayload(partialIn2);
         outSock->send(msg);
@@ -38,18 +38,29 @@ void    FCLayer1::sendVal()
         }
         else
         {
-            std::cout << "loss rate (id=" << id << "): " << lossCnt/(double)(49*numSamples) << std::endl;
+            std::cout << "loss rate (id=" << id << "): " << lossCnt/(double)(numTiles*numSamples) << std::endl;
         }
 }
 
 void    FCLayer1::setOutVal()
 {
-        buffer->waitForToken(GRID_WIDTH*GRID_WIDTH);
+        buffer->waitForToken(numTiles);
 
-        // set "out1" by traversing tiles (tokens)
-        for(uint tileIdx=0; tileIdx<(GRID_WIDTH*GRID_WIDTH); tileIdx++)
+        // tiles were summed as they arrived (see addTile), only those evicted since need a second pass
+        auto it = partials.find(iterCnt);
+        auto qIt = qPartials.find(iterCnt);
+        bool stale = (iterCnt < staleUntil);
+        int32_t qSums[16];
+
+        for(int i=0; i<16; i++)
+        {
+            partialIn2.array[i] = ((it != partials.end()) && !stale)? it->second[i] : 0.0;
+            qSums[i] = ((qIt != qPartials.end()) && !stale)? qIt->second[i] : 0;
+        }
+
+        for(uint tileIdx=0; tileIdx<numTiles; tileIdx++)
         {
-            token& tile = buffer->readToken(tileIdx);
+            auto& tile = buffer->readToken(tileIdx);
 
             if(tile.isEmpty())
             {
@@ -59,42 +70,85 @@ void    FCLayer1::setOutVal()
                 std::cout << "@iteration " << iterCnt << " FCLayer1 (id=" << id << ")'s tile#" << tileIdx << " was empty!" << std::endl;
                 #endif
             }
+            else if(stale)
+            {
+                accumulate(tileIdx, tile.getData().bits, doubleSums? partialIn2.array : nullptr, quantized? qSums : nullptr);
+            }
+        }
 
-            uint tileX = tileIdx%GRID_WIDTH;
-            uint tileY = tileIdx/GRID_WIDTH;
+        buffer->popToken(numTiles);
+        partials.erase(partials.begin(), partials.upper_bound(iterCnt));
+        qPartials.erase(qPartials.begin(), qPartials.upper_bound(iterCnt));
 
-            uint minX = (tileX*TILE_WIDTH);
-            uint minY = (tileY*TILE_WIDTH);
+        for(int i=0; i<16; i++)
+        {
+            partialIn2.array[i] = doubleSums? sigmoid(partialIn2.array[i]) : 0.0;
+            partialIn2.quant[i] = quantized? quantizeActivation(sigmoid(q1->scale[i]*qSums[i])) : 0;
+        }
 
-            // traversal of elements inside each tile
-            for(uint offset=0; offset<(TILE_WIDTH*TILE_WIDTH); offset++)
-            {
-                uint x = minX + (offset%TILE_WIDTH);
-                uint y = minY + (offset/TILE_WIDTH);
+        selfMsg->setKind(PUSH);
+        scheduleAt(simTime()+wcet, selfMsg);
+}
 
-                uint index = (IN_WIDTH*y) + x;
+/* tile as kept by the buffer, i.e. decoded to the bitmap of its pixels */
+struct  decodedTile
+{
+        uint            seqN;
+        tileBits        tile;
 
-                if(tile.isEmpty())
-                    out1[index] = 0.0;
-                else
-                    out1[index] = tile.getData().array[offset];
-            }
+        uint            getSequenceNumber() const   { return seqN; }
+        const tileBits& getPayload()        const   { return tile; }
+};
+
+/* multiplies a tile with its weights as soon as the buffer accepts it */
+void    FCLayer1::addTile(tilePacket *pkt)
+{
+        const tileData& payload = pkt->getPayload();
+
+        if((payload.pixels != tileWidth*tileWidth) || (payload.tileSize != encodedSize((tileEncoding)payload.encoding, payload.pixels)))
+        {
+            std::cout << "FCLayer1 (id=" << id << ") received a tile of " << payload.pixels << " pixels, expected " << tileWidth << "x" << tileWidth << " (tileWidth of the Sensor)" << std::endl;
+            exit(1);
         }
 
-        buffer->popToken(GRID_WIDTH*GRID_WIDTH);
+        unsigned long evicted = buffer->getCounters().evicted;
+        decodedTile decoded{};      // the words past the tile stay zero in the copy the buffer keeps
 
-        for(int i=0; i<16; i++)
+        decoded.seqN = pkt->getSequenceNumber();
+        decodeTile((tileEncoding)payload.encoding, payload.tile, payload.pixels, decoded.tile.bits);
+
+        if(buffer->addToken(&decoded))
         {
-            partialIn2.array[i] = 0.0;
+            uint iter = decoded.seqN/numTiles;
 
-            for(int j=0; j<N1; j++)
-                partialIn2.array[i] += out1[j] * w1[j+1][(16*id)+i+1];
+            accumulate(decoded.seqN%numTiles, decoded.tile.bits, doubleSums? partials[iter].data() : nullptr, quantized? qPartials[iter].data() : nullptr);
+        }
 
-            partialIn2.array[i] = sigmoid(partialIn2.array[i]);
+        // tiles below the window were pushed out after they were summed
+        if(buffer->getCounters().evicted != evicted)
+        {
+            uint iter = ((buffer->windowStart()-1)/numTiles)+1;
+
+            if(iter > staleUntil)
+                staleUntil = iter;
         }
+}
 
-        selfMsg->setKind(PUSH);
-        scheduleAt(simTime()+wcet, selfMsg);
+/* adds tile "tileIdx" to the hidden neurons 64 pixels at a time, "sums" with the double and "qSums" with the int8 weights unless they are null */
+void    FCLayer1::accumulate(uint tileIdx, const uint64_t* bits, double* sums, int32_t* qSums)
+{
+        uint pixels = tileWidth*tileWidth;
+
+        for(uint word=0; (64*word)<pixels; word++)
+        {
+            uint offset = ((tileIdx*pixels)+(64*word))*PART_WIDTH;
+
+            if(sums)
+                accumulateBits(w1 + offset, bits[word], sums);
+
+            if(qSums)
+                accumulateBitsQ(q1->w.data() + offset, bits[word], qSums);
+        }
 }
 
 void    FCLayer1::handleMessageWhenUp(cMessage* msg)
@@ -123,14 +177,14 @@ void    FCLayer1::handleMessageWhenUp(cMessage* msg)
                 std::cout << "Received data from unexpected IP address" << std::endl;
                 exit(1);
             }
-            if((uint)ctrl->getDestPort() != get_L0_L1_portnum(id))
+            if((uint)ctrl->getDestPort() != inPort)
             {
                 std::cout << "Received data from unexpected port number" << std::endl;
                 exit(1);
             }
 
             //std::cout << "@iteration " << iterCnt << " (t=" << simTime() << ") FCLayer1 (id=" << id << ") received data";
-            buffer->addToken(PK(msg));
+            addTile(check_and_cast<tilePacket*>(msg));
 
             delete msg;
             delete ctrl;
@@ -158,20 +212,48 @@ void    FCLayer1::initialize(int stage)
             period = par("period");
             int mem = par("mem");
             numSamples = par("numSamples");
+            str2 op = par("overflowPolicy");
 
             //std::cout << "mem=" << mem << std::endl;
 
+            tileBuffer::OverflowPolicy policy;
+            if(!tileBuffer::parsePolicy(op, policy))
+            {
+                std::cout << "unknown overflow policy " << op << ", dropping newest tokens" << std::endl;
+                policy = tileBuffer::DROP_NEWEST;
+            }
+
             inSock = new sock();
             outSock = new sock();
             selfMsg = new cMessage("scheduler");
-            buffer = new udpBuffer((GRID_WIDTH*GRID_WIDTH*mem));    // 28*28 = 16*49
+            tileWidth = checkTileWidth(par("tileWidth"));
+            numTiles = (IN_WIDTH/tileWidth)*(IN_WIDTH/tileWidth);
+            buffer = new tileBuffer((numTiles*mem), policy);     // e.g. 28*28 = 16*49
 
             inSock->setOutputGate(gate("udpOut"));
             outSock->setOutputGate(gate("udpOut"));
-            inSock->bind(getIP(id+1),get_L0_L1_portnum(id));    // id:0=>(h1,10000), id:1=>(h2,10001), ...
+            if(par("multicast").boolValue())
+            {
+                inPort = get_L0_L1_group_portnum();
+                inSock->bind(inPort);                               // any address, i.e. the group's as well
+                inSock->joinMulticastGroup(getL1Group());
+            }
+            else
+            {
+                inPort = get_L0_L1_portnum(id);
+                inSock->bind(getIP(id+1),inPort);                   // id:0=>(h1,10000), id:1=>(h2,10001), ...
+            }
             outSock->connect(getIP(9),get_L1_L2_portnum(id));   // h9 hosts FC2
 
-            loadWeights(par("path_to_model"));
+            const weightStore& weights = weightStore::get(par("path_to_model").stdstringValue());
+
+            // quantized alone only builds the int8 weights, referenceAccuracy needs the double ones as well
+            quantized = par("quantized");
+            doubleSums = !quantized || par("referenceAccuracy").boolValue();
+            if(doubleSums)
+                w1 = weights.tiledLayer1(id, tileWidth);
+            if(quantized)
+                q1 = &weights.quantLayer1(id, tileWidth);
         }
 }
 
@@ -195,14 +277,8 @@ FCLayer1::~FCLayer1()
 }
 
 FCLayer1::FCLayer1()
-:   id(0), lossCnt(0), iterCnt(0), numSamples(0), ts(0.0), wcet(0.0), period(0.0)
-{
-        for (int i = 1; i <= N1; ++i)
-        {
-            w1[i] = new double [N2 + 1];
-        }
-
-}
+:   id(0), lossCnt(0), iterCnt(0), numSamples(0), tileWidth(0), numTiles(0), inPort(0), staleUntil(0), quantized(false), doubleSums(true), ts(0.0), wcet(0.0), period(0.0), w1(nullptr), q1(nullptr)
+{}
 
 void    FCLayer1::handleNodeCrash()
 {
@@ -214,29 +290,3 @@ bool    FCLayer1::handleNodeShutdown(inet::IDoneCallback *doneCallBack)
         std::cout << "FCLayer1 (id=" << id << ") shutdown." << std::endl;
         return true;
 }
-
-void    FCLayer1::loadWeights(str2 file_name)
-{
-        double temp;
-        std::ifstream file(file_name.c_str(), std::ifstream::in);
-
-        // Input layer - Hidden layer
-        for (int i = 1; i <= N1; ++i)
-        {
-            for (int j = 1; j <= N2; ++j)
-            {
-                file >> w1[i][j];
-            }
-        }
-
-        // Hidden layer - Output layer
-        for (int i = 1; i <= N2; ++i)
-        {
-            for (int j = 1; j <= N3; ++j)
-            {
-                file >> temp; //w2[i][j];
-            }
-        }
-
-        file.close();
-}
@@ -17,6 +17,9 @@
 #define MNIST_FCLAYER1_H
 
 #include "../include/typedefs.h"
+#include "../include/weightStore.h"
+#include "../include/tileKernel.h"
+#include "../include/quantKernel.h"
 
 
 class INET_API FCLayer1 : public inet::ApplicationBase
@@ -26,17 +29,25 @@ class INET_API FCLayer1 : public inet::ApplicationBase
     enum            SelfMsgKinds { POP=1, PUSH };
 
     uint            id, lossCnt, iterCnt, numSamples;
+    uint            tileWidth, numTiles;
+    uint            inPort;             // own port, or the one of the group if tiles are multicast
+    uint            staleUntil;         // iterations below lost summed tiles to dropOldest and are summed again
+    bool            quantized;          // send int8 hidden neurons
+    bool            doubleSums;         // sum with the double weights, always without quantized and for referenceAccuracy with it
     sock            *inSock, *outSock;
     nnData          partialIn2;
     double          ts, wcet, period;
-    double          out1[N1];
     cMessage*       selfMsg;
-    udpBuffer*      buffer;
-    double          *w1[N1 + 1];        // From layer 1 to layer 2. Or: Input layer - Hidden layer
+    tileBuffer*     buffer;
+    std::map<uint,std::array<double,16>>    partials;   // sums of the tiles received so far, per iteration
+    std::map<uint,std::array<int32_t,16>>   qPartials;  // same with int8 weights, before the scale of each neuron
+    const double*   w1;                 // From layer 1 to layer 2, this partition only and by tile (see weightStore), doubleSums only
+    const weightStore::quantLayer*  q1; // same in int8, quantized mode only
 
     void            sendVal();
     void            setOutVal();
-    void            loadWeights(str2 path_to_model);
+    void            addTile(tilePacket *pkt);
+    void            accumulate(uint tileIdx, const uint64_t* bits, double* sums, int32_t* qSums);
 
     protected:
 
@@ -20,9 +20,12 @@ Define_Module(FCLayer2);
 
 void    FCLayer2::sendVal()
 {
-        int predict = predictLabel();
+        int predict = predictLabel(out3);
         int currentLabel = setExpected();
 
+        if(quantized && doubleSums && (predictLabel(refOut3) == currentLabel))
+            ++refCorrect;
+
         // Write down the classification result and the squared error
         double error = square_error();
         printf("Error: %0.6lf\n", error);
@@ -43,6 +46,21 @@ void    FCLayer2::sendVal()
         }
 
         iterCnt++;
+
+        /* stop as soon as the accuracy is known precisely enough, numSamples is the hard cap */
+        if(accuracyCI)
+        {
+            accuracyCI->observe((currentLabel == predict)? 1.0 : 0.0);
+
+            if(accuracyCI->converged(targetPrecision))
+            {
+                std::cout << "Accuracy converged after " << iterCnt << " samples (+/- " << 100.0*accuracyCI->halfWidth() << ")" << std::endl;
+                printAccuracy();
+                endSimulation();
+                return;
+            }
+        }
+
         if(iterCnt < numSamples)
         {
             selfMsg->setKind(POP);
@@ -50,18 +68,40 @@ void    FCLayer2::sendVal()
         }
         else
         {
-            std::cout << "loss rate: ";
-            for(uint id=0; id<8; id++)
-                std::cout << lossCnts[id]/(double)numSamples << " ";
-            std::cout << std::endl;
+            printAccuracy();
+        }
+}
 
-            uint  numSamples = par("numSamples");
-            double accuracy = (double)(nCorrect) / numSamples * 100.0;
-            std::cout << "Number of correct samples: " << nCorrect << " / " << numSamples << std::endl;
-            printf("Accuracy: %0.2lf\n", accuracy);
+void    FCLayer2::printAccuracy()
+{
+        std::cout << "loss rate: ";
+        for(uint id=0; id<8; id++)
+            std::cout << lossCnts[id]/(double)iterCnt << " ";
+        std::cout << std::endl;
 
-            report << "Number of correct samples: " << nCorrect << " / " << numSamples << std::endl;
-            report << "Accuracy: " << accuracy << endl;
+        double accuracy = (double)(nCorrect) / iterCnt * 100.0;
+        std::cout << "Number of correct samples: " << nCorrect << " / " << iterCnt << std::endl;
+        printf("Accuracy: %0.2lf\n", accuracy);
+
+        report << "Number of correct samples: " << nCorrect << " / " << iterCnt << std::endl;
+        report << "Accuracy: " << accuracy << endl;
+
+        /* same samples and losses through the double weights, i.e. what quantization costs */
+        if(quantized)
+        {
+            report << "Mode: int8" << std::endl;
+
+            if(doubleSums)
+            {
+                double refAccuracy = (double)(refCorrect) / iterCnt * 100.0;
+                printf("Accuracy (double reference): %0.2lf\n", refAccuracy);
+
+                report << "Accuracy (double reference): " << refAccuracy << std::endl;
+            }
+        }
+        else
+        {
+            report << "Mode: double" << std::endl;
         }
 }
 
@@ -70,44 +110,100 @@ void    FCLayer2::setOutVal()
         for(uint id=0; id<8; id++)
             buffers[id]->waitForToken(1);
 
-        for(int j=0; j<N3; j++)
+        // tokens were summed as they arrived (see addToken), only those evicted since need a second pass
+        auto it = partials.find(iterCnt);
+        auto qIt = qPartials.find(iterCnt);
+        bool stale = (iterCnt < staleUntil);
+        std::array<double,N3> sums, qSums;
+
+        if((it != partials.end()) && !stale)
+            sums = it->second;
+        else
+            sums.fill(0.0);
+
+        if((qIt != qPartials.end()) && !stale)
+            qSums = qIt->second;
+        else
+            qSums.fill(0.0);
+
+        // break n2 (128) to 16*8
+        for(uint id=0; id<8; id++)
         {
-            in3[j+1] = 0.0;
+            auto& nnToken = buffers[id]->readToken(0);
 
-            // break n2 (128) to 16*8
-            for(uint id=0; id<8; id++)
+            /* empty token does not add anything to sum */
+            if(nnToken.isEmpty())
             {
-                token& nnToken = buffers[id]->readToken(0);
+                #ifdef EMPTY
+                std::cout << "FCLayer2 received an empty token from producer " << id << std::endl;
+                #endif
 
-                /* empty token does not add anything to sum */
-                if(nnToken.isEmpty())
-                {
-                    #ifdef EMPTY
-                    std::cout << "FCLayer2 received an empty token from producer " << id << std::endl;
-                    #endif
+                lossCnts[id]++;
+            }
+            else if(stale)
+            {
+                if(doubleSums)
+                    addPartial(id, nnToken.getData().array, sums);
 
-                    lossCnts[id]++;
-                    continue;
-                }
+                if(quantized)
+                    addPartialQ(id, nnToken.getData().quant, qSums);
+            }
 
-                auto parIn2 = nnToken.getData();
+            buffers[id]->popToken(1);
+        }
 
-                for(int i=0; i<16; i++)
-                {
-                    in3[j+1] += parIn2.array[i] * w2[(16*id)+i+1][j+1];
-                }
-            }
+        partials.erase(partials.begin(), partials.upper_bound(iterCnt));
+        qPartials.erase(qPartials.begin(), qPartials.upper_bound(iterCnt));
 
+        for(int j=0; j<N3; j++)
+        {
+            in3[j+1] = quantized? qSums[j] : sums[j];
             out3[j+1] = sigmoid(in3[j+1]);
+            refOut3[j+1] = sigmoid(sums[j]);
         }
 
-        for(uint id=0; id<8; id++)
-            buffers[id]->popToken(1);
-
         selfMsg->setKind(PUSH);
         scheduleAt(simTime()+wcet, selfMsg);
 }
 
+/* adds the 16 hidden neurons of partition "id" to the sums of the output neurons */
+void    FCLayer2::addPartial(uint id, const double* parIn2, std::array<double,N3>& sums)
+{
+        for(int i=0; i<16; i++)
+        {
+            const double* w = w2 + (((16*id)+i)*N3);
+
+            for(int j=0; j<N3; j++)
+                sums[j] += parIn2[i] * w[j];
+        }
+}
+
+/* same with int8 hidden neurons and weights, the integer dot product is scaled back per output neuron */
+void    FCLayer2::addPartialQ(uint id, const int8_t* parIn2, std::array<double,N3>& sums)
+{
+        for(int j=0; j<N3; j++)
+            sums[j] += (q2->scale[j]/ACT_MAX) * dotQ16(parIn2, q2->w.data() + (j*N2) + (16*id));
+}
+
+/* sums a token as soon as the buffer of its producer accepts it */
+void    FCLayer2::addToken(uint id, nnPacket *pkt)
+{
+        unsigned long evicted = buffers[id]->getCounters().evicted;
+
+        if(buffers[id]->addToken(pkt))
+        {
+            if(doubleSums)
+                addPartial(id, pkt->getPayload().array, partials[pkt->getSequenceNumber()]);
+
+            if(quantized)
+                addPartialQ(id, pkt->getPayload().quant, qPartials[pkt->getSequenceNumber()]);
+        }
+
+        // tokens below the window were pushed out after they were summed
+        if((buffers[id]->getCounters().evicted != evicted) && (buffers[id]->windowStart() > staleUntil))
+            staleUntil = buffers[id]->windowStart();
+}
+
 /* don't use */
 void    FCLayer2::showImage()
 {
@@ -123,13 +219,13 @@ void    FCLayer2::showImage()
         std::cout << std::endl;
 }
 
-int     FCLayer2::predictLabel()
+int     FCLayer2::predictLabel(const double* out)
 {
         // Prediction
         int predict = 1;
         for (int i = 2; i <= N3; ++i)
         {
-            if (out3[i] > out3[predict])
+            if (out[i] > out[predict])
             {
                 predict = i;
             }
@@ -141,14 +237,19 @@ int     FCLayer2::predictLabel()
 
 int     FCLayer2::setExpected()
 {
-        char number;
-        // Reading label
-        label.read(&number, sizeof(char));
+        int number = labels->item(samples[iterCnt])[0];
+
+        if(number >= N3)
+        {
+            std::cout << "label " << number << " of sample " << samples[iterCnt] << " is not a digit" << std::endl;
+            exit(1);
+        }
+
         for (int i = 1; i <= N3; ++i)
             expected[i] = 0.0;
         expected[number + 1] = 1.0;
 
-        return (int) number;
+        return number;
 }
 
 void    FCLayer2::handleMessageWhenUp(cMessage* msg)
@@ -189,7 +290,7 @@ void    FCLayer2::handleMessageWhenUp(cMessage* msg)
             }
 
             //std::cout << "@iteration " << iterCnt << " (t=" << simTime() << ") FCLayer2 received data from id=" << id;
-            buffers[id]->addToken(PK(msg));
+            addToken(id, check_and_cast<nnPacket*>(msg));
 
             delete msg;
             delete ctrl;
@@ -216,7 +317,14 @@ void    FCLayer2::initialize(int stage)
             wcet = par("wcet");
             period = par("period");
             numSamples = par("numSamples");
-            loadWeights(par("path_to_model"));
+            targetPrecision = par("targetPrecision");
+            if(targetPrecision > 0.0)
+                accuracyCI = new batchMeans((uint)par("ciBatchSize"), (uint)par("ciMinBatches"));
+            w2 = weightStore::get(par("path_to_model").stdstringValue()).layer2();
+            quantized = par("quantized");
+            doubleSums = !quantized || par("referenceAccuracy").boolValue();
+            if(quantized)
+                q2 = &weightStore::get(par("path_to_model").stdstringValue()).quantLayer2();
 
             str2 path2label = par("path_to_label");
             str2 path2report = par("path_to_report");
@@ -224,15 +332,21 @@ void    FCLayer2::initialize(int stage)
             const char *mem_str = par("mem").stringValue();
             arr<int> mems = cStringTokenizer(mem_str).asIntVector();
 
+            str2 op = par("overflowPolicy");
+            nnBuffer::OverflowPolicy policy;
+            if(!nnBuffer::parsePolicy(op, policy))
+            {
+                std::cout << "unknown overflow policy " << op << ", dropping newest tokens" << std::endl;
+                policy = nnBuffer::DROP_NEWEST;
+            }
+
             report.open(path2report.c_str(), std::ofstream::out);
-            label.open(path2label.c_str(), std::ifstream::in | std::ifstream::binary ); // Binary label file
 
-            //std::cout << "mem=" << mem_str << std::endl;
+            labels = &idxFile::get(path2label, {});
+            labels->checkPairedWith(idxFile::get(par("path_to_image").stdstringValue(), { IN_WIDTH, IN_WIDTH }));
+            samples = labels->order(par("firstSample"), numSamples, par("shuffle"), par("shuffleSeed"));
 
-            // Reading file headers
-            char number;
-            for (int i = 1; i <= 8; ++i)
-                label.read(&number, sizeof(char));
+            //std::cout << "mem=" << mem_str << std::endl;
 
             for(uint id=0; id<8; id++)
             {
@@ -241,7 +355,7 @@ void    FCLayer2::initialize(int stage)
                 sPtr->bind(getIP(9),get_L1_L2_portnum(id));
 
                 inSockets.push_back(sPtr);
-                buffers.push_back(new udpBuffer(mems[id]));
+                buffers.push_back(new nnBuffer(mems[id], policy));
             }
 
             selfMsg = new cMessage("scheduler");
@@ -262,25 +376,22 @@ FCLayer2::~FCLayer2()
         if(selfMsg) { cancelEvent(selfMsg); }
 
         for(sock* socket:inSockets) delete socket;
-        for(udpBuffer* buff:buffers) delete buff;
+        for(nnBuffer* buff:buffers) delete buff;
 
         delete  selfMsg;
+        delete  accuracyCI;
+        delete[] in3;
+        delete[] out3;
 
-        label.close();
         report.close();
 }
 
 FCLayer2::FCLayer2()
-:   mem(1), iterCnt(0), nCorrect(0), numSamples(0), ts(0.0), wcet(0.0), period(0.0)
+:   mem(1), iterCnt(0), nCorrect(0), refCorrect(0), numSamples(0), staleUntil(0), quantized(false), doubleSums(true), ts(0.0), wcet(0.0), period(0.0), targetPrecision(0.0), accuracyCI(nullptr), w2(nullptr), q2(nullptr), labels(nullptr)
 {
         for(uint i=0; i<8; i++)
             lossCnts[i] = 0;
 
-        for (int i = 1; i <= N2; ++i)
-        {
-            w2[i] = new double [N3 + 1];
-        }
-
         in3 = new double [N3 + 1];
         out3 = new double [N3 + 1];
 }
@@ -296,32 +407,6 @@ bool    FCLayer2::handleNodeShutdown(inet::IDoneCallback *doneCallBack)
         return true;
 }
 
-void    FCLayer2::loadWeights(str2 file_name)
-{
-        double temp;
-        std::ifstream file(file_name.c_str(), std::ifstream::in);
-
-        // Input layer - Hidden layer
-        for (int i = 1; i <= N1; ++i)
-        {
-            for (int j = 1; j <= N2; ++j)
-            {
-                file >> temp; //w1[i][j];
-            }
-        }
-
-        // Hidden layer - Output layer
-        for (int i = 1; i <= N2; ++i)
-        {
-            for (int j = 1; j <= N3; ++j)
-            {
-                file >> w2[i][j];
-            }
-        }
-
-        file.close();
-}
-
 double  FCLayer2::square_error()
 {
         double res = 0.0;
@@ -17,6 +17,9 @@
 #define MNIST_FCLAYER2_H
 
 #include "../include/typedefs.h"
+#include "../include/weightStore.h"
+#include "../include/quantKernel.h"
+#include "../include/idxFile.h"
 
 class INET_API FCLayer2 : public inet::ApplicationBase
 {
@@ -24,24 +27,37 @@ class INET_API FCLayer2 : public inet::ApplicationBase
 
     enum            SelfMsgKinds { POP=1, PUSH };
 
-    uint            mem, iterCnt, nCorrect, numSamples;
+    uint            mem, iterCnt, nCorrect, refCorrect, numSamples;
     uint            lossCnts[8];
+    uint            staleUntil;         // iterations below lost summed tokens to dropOldest and are summed again
+    bool            quantized;          // predict from the int8 hidden neurons
+    bool            doubleSums;         // sum the double hidden neurons, always without quantized and for referenceAccuracy with it, refCorrect counts them
     double          ts, wcet, period;
-    double          *w2[N2 + 1];
+    double          targetPrecision;    // relative half width of the accuracy CI to stop at, 0 to run numSamples
+    batchMeans*     accuracyCI;
+    const double*   w2;                 // Hidden layer - Output layer (see weightStore)
+    const weightStore::quantLayer*  q2; // same in int8, quantized mode only
     double          *in3, *out3;
+    double          refOut3[N3 + 1];    // output of the double hidden neurons for referenceAccuracy
     double          expected[N3 + 1];
     cMessage*       selfMsg;
     arr<sock*>      inSockets;
-    std::ifstream   label;
     std::ofstream   report;
-    arr<udpBuffer*> buffers;
+    arr<nnBuffer*>  buffers;
+    arr<uint>       samples;            // label of every iteration, same order as the Sensor's images
+    const idxFile*  labels;
+    std::map<uint,std::array<double,N3>>    partials;   // sums of the tokens received so far, per iteration
+    std::map<uint,std::array<double,N3>>    qPartials;  // same for the int8 hidden neurons
 
     int             setExpected();
-    int             predictLabel();
+    int             predictLabel(const double* out);
     void            sendVal();
+    void            printAccuracy();
     void            setOutVal();
+    void            addPartial(uint id, const double* parIn2, std::array<double,N3>& sums);
+    void            addPartialQ(uint id, const int8_t* parIn2, std::array<double,N3>& sums);
+    void            addToken(uint id, nnPacket *pkt);
     void            showImage();
-    void            loadWeights(str2 path_to_model);
     double          square_error();
 
     protected:
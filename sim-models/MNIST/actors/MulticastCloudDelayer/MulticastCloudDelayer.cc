@@ -0,0 +1,101 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include "MulticastCloudDelayer.h"
+
+Define_Module(MulticastCloudDelayer);
+
+MulticastCloudDelayer::MulticastCloudDelayer()
+:       streams(nullptr)
+{}
+
+MulticastCloudDelayer::~MulticastCloudDelayer()
+{
+        delete streams;
+}
+
+void    MulticastCloudDelayer::initialize(int stage)
+{
+        MatrixCloudDelayer::initialize(stage);
+
+        if((stage == inet::INITSTAGE_LOCAL) && par("commonRandomNumbers").boolValue())
+        {
+            const linkModel& links = linkModel::get(par("linkModel").stdstringValue());
+
+            hosts.init(this, inet::getModuleFromPar<inet::IInterfaceTable>(par("interfaceTableModule"), this));
+            streams = new linkStreams(links, (uint)par("crnSeed").intValue());
+            queue.init(links.hostCount(), par("datarate").doubleValue());
+        }
+}
+
+/* index of the host behind an interface of the cloud, "h[3]" -> 3 */
+int     MulticastCloudDelayer::hostOf(int interfaceId)
+{
+        int hostIdx = hosts.hostOf(interfaceId);
+
+        if(hostIdx < 0)
+            throw cRuntimeError("Interface %d of the cloud is not connected to a host of the \"h\" vector", interfaceId);
+
+        return hostIdx;
+}
+
+/* sequence number of the tile or hidden neurons a datagram carries, -1 if it carries something else */
+long    MulticastCloudDelayer::sequenceNumberOf(const cMessage *msg)
+{
+        if(const tilePacket *tp = findPacket<tilePacket>(msg))
+            return tp->getSequenceNumber();
+
+        if(const nnPacket *np = findPacket<nnPacket>(msg))
+            return np->getSequenceNumber();
+
+        return -1;
+}
+
+void    MulticastCloudDelayer::calculateDropAndDelay(const cMessage *msg, int srcID, int destID, bool& outDrop, simtime_t& outDelay)
+{
+        Enter_Method_Silent();
+
+        /* tokens draw from their own stream, anything else goes through the XML patterns */
+        long seqN = streams? sequenceNumberOf(msg) : -1;
+
+        if(seqN < 0)
+        {
+            MatrixCloudDelayer::calculateDropAndDelay(msg, srcID, destID, outDrop, outDelay);
+            return;
+        }
+
+        /* each link carries a single kind of token, so the sequence number alone identifies it */
+        uint src = hostOf(srcID);
+        uint dst = hostOf(destID);
+        const linkStreams::draw& d = streams->sample(src, dst, 0, (uint)seqN);
+
+        outDrop = d.lost;
+        outDelay = d.delay;
+
+        if(outDrop)
+            return;
+
+        /* packets of a host pair queue behind each other, like the "datarate" of the XML patterns */
+        outDelay += queue.delay(src, dst, check_and_cast<const cPacket*>(msg)->getBitLength(), simTime());
+}
+
+inet::INetfilter::IHook::Result MulticastCloudDelayer::datagramPostRoutingHook(inet::INetworkDatagram *datagram, const inet::InterfaceEntry *inIE, const inet::InterfaceEntry *& outIE, inet::L3Address& nextHopAddr)
+{
+        // unicast packets were handled by the forward hook already, packets of the cloud itself are not delayed
+        if(!inIE || !datagram->getDestinationAddress().isMulticast())
+            return MatrixCloudDelayer::datagramPostRoutingHook(datagram, inIE, outIE, nextHopAddr);
+
+        return datagramForwardHook(datagram, inIE, outIE, nextHopAddr);
+}
@@ -0,0 +1,61 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef MNIST_MULTICAST_CLOUD_DELAYER_H
+#define MNIST_MULTICAST_CLOUD_DELAYER_H
+
+#include "../include/typedefs.h"
+#include "../../../common/linkStreams.h"
+#include "../../../common/cloudHosts.h"
+#include <inet/node/internetcloud/MatrixCloudDelayer.h>
+#include <inet/networklayer/contract/IInterfaceTable.h>
+
+/*
+    MatrixCloudDelayer that also delays and drops multicast packets.
+
+    IPv4 runs the forward hook, where the cloud delayers work, for unicast packets only. Multicast
+    packets are copied once per outgoing interface of their route and each copy only passes the
+    post-routing hook, so that is where they get the delay and loss of their (input, output) pair.
+
+    With commonRandomNumbers, delay and loss of the tokens (tilePacket, nnPacket) come from counter-based streams
+    per (source, destination, sequence number) of the network description instead of the XML
+    patterns, so the baseline and the optimized schedule see the same draws per repetition.
+*/
+
+class   INET_API MulticastCloudDelayer : public inet::MatrixCloudDelayer
+{
+        private:
+
+        int         hostOf(int interfaceId);
+        static  long    sequenceNumberOf(const cMessage *msg);
+
+        cloudHosts              hosts;
+        linkStreams*            streams;                /* common random numbers per link and token, nullptr if disabled */
+        linkQueue               queue;                  /* datarate of each host pair for the tokens drawn from streams */
+
+        protected:
+
+        virtual void    initialize(int stage) override;
+        virtual void    calculateDropAndDelay(const cMessage *msg, int srcID, int destID, bool& outDrop, simtime_t& outDelay) override;
+
+        public:
+
+        MulticastCloudDelayer();
+        ~MulticastCloudDelayer();
+
+        virtual inet::INetfilter::IHook::Result datagramPostRoutingHook(inet::INetworkDatagram *datagram, const inet::InterfaceEntry *inIE, const inet::InterfaceEntry *& outIE, inet::L3Address& nextHopAddr) override;
+};
+
+#endif /* MNIST_MULTICAST_CLOUD_DELAYER_H */
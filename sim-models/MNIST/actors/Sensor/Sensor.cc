@@ -21,38 +21,46 @@ Define_Module(Sensor);
 
 void    Sensor::sendVal()
 {
-        nnData  tiles[GRID_WIDTH*GRID_WIDTH];
+        uint numTiles = gridWidth*gridWidth;
+        uint numPixels = tileWidth*tileWidth;
+        arr<tileData> tiles(numTiles);
+        arr<double> pixels(numPixels);
 
-        for(uint tileIdx=0; tileIdx<(GRID_WIDTH*GRID_WIDTH); tileIdx++)
+        for(uint tileIdx=0; tileIdx<numTiles; tileIdx++)
         {
             // row first tiling
-            uint tileX = tileIdx%GRID_WIDTH;
-            uint tileY = tileIdx/GRID_WIDTH;
+            uint tileX = tileIdx%gridWidth;
+            uint tileY = tileIdx/gridWidth;
 
-            uint minX = tileX*TILE_WIDTH;
-            uint minY = tileY*TILE_WIDTH;
+            uint minX = tileX*tileWidth;
+            uint minY = tileY*tileWidth;
 
-            // row first serialization
-            for(uint offset=0; offset<(TILE_WIDTH*TILE_WIDTH); offset++)
+            // row first serialization, binarized
+            for(uint offset=0; offset<numPixels; offset++)
             {
-                uint x = minX + (offset%TILE_WIDTH);
-                uint y = minY + (offset/TILE_WIDTH);
+                uint x = minX + (offset%tileWidth);
+                uint y = minY + (offset/tileWidth);
 
-                tiles[tileIdx].array[offset] = d[x+1][y+1];
+                pixels[offset] = image[(IN_WIDTH*y)+x]? 1.0 : 0.0;
             }
+
+            tiles[tileIdx].encoding = encoding;
+            tiles[tileIdx].pixels = numPixels;
+            tiles[tileIdx].tileSize = encodeTile(encoding, pixels.data(), numPixels, tiles[tileIdx].tile);
         }
 
-        for(uint tileIdx=0; tileIdx<(GRID_WIDTH*GRID_WIDTH); tileIdx++)
+        for(uint tileIdx=0; tileIdx<numTiles; tileIdx++)
         {
             //std::cout << "@iteration " << iterCnt << " sending tile " << tileIdx << " to FCLayer1" << std::endl;
 
-            for(uint id=0; id<8; id++)
+            // one socket per FCLayer1, or a single one for the whole group
+            for(sock* outSock:outSockets)
             {
-                nnPacket *msg = new nnPacket("token");
-                msg->setByteLength(sizeof(nnData)+sizeof(uint));
-                msg->setSequenceNumber((GRID_WIDTH*GRID_WIDTH*iterCnt)+tileIdx);
+                tilePacket *msg = new tilePacket("token");
+                msg->setByteLength(tiles[tileIdx].tileSize+sizeof(uint));
+                msg->setSequenceNumber((numTiles*iterCnt)+tileIdx);
                 msg->setPayload(tiles[tileIdx]);
-                outSockets[id]->send(msg);
+                outSock->send(msg);
             }
         }
 
@@ -66,23 +74,8 @@ void    Sensor::sendVal()
 
 void    Sensor::setOutVal()
 {
-        char number;
-        for (int j = 1; j <= IN_WIDTH; ++j)
-        {
-            for (int i = 1; i <= IN_WIDTH; ++i)
-            {
-                image.read(&number, sizeof(char));
-
-                if (number == 0)
-                {
-                    d[i][j] = 0;
-                }
-                else
-                {
-                    d[i][j] = 1;
-                }
-            }
-        }
+        // pixels are binarized (0 or not) as the tiles are built
+        image = images->item(samples[iterCnt]);
 
         selfMsg->setKind(PUSH);
         scheduleAt(simTime()+wcet, selfMsg);
@@ -99,21 +92,48 @@ void    Sensor::initialize(int stage)
             period = par("period");
             numSamples = par("numSamples");
             str2 path2image = par("path_to_image");
-            image.open(path2image.c_str(), std::ifstream::in | std::ifstream::binary); // Binary image file
+            str2 enc = par("encoding");
 
-            // Reading file headers
-            char number;
-            for (int i = 1; i <= 16; ++i)
-                image.read(&number, sizeof(char));
+            tileWidth = checkTileWidth(par("tileWidth"));
+            gridWidth = IN_WIDTH/tileWidth;
 
-            for(uint id=0; id<8; id++)
+            if(!parseEncoding(enc, encoding))
             {
+                std::cout << "unknown tile encoding " << enc << std::endl;
+                exit(1);
+            }
+
+            if(encodedSize(encoding, tileWidth*tileWidth) > TILE_BYTES)
+            {
+                std::cout << "a tile of " << tileWidth << "x" << tileWidth << " pixels encoded as " << enc << " takes " << encodedSize(encoding, tileWidth*tileWidth) << " bytes, tokens carry at most " << TILE_BYTES << std::endl;
+                exit(1);
+            }
+
+            images = &idxFile::get(path2image, { IN_WIDTH, IN_WIDTH });
+            images->checkPairedWith(idxFile::get(par("path_to_label").stdstringValue(), {}));
+            samples = images->order(par("firstSample"), numSamples, par("shuffle"), par("shuffleSeed"));
+
+            if(par("multicast").boolValue())
+            {
+                // the cloud copies each tile to h1..h8, the TTL has to outlive that hop
                 auto sPtr = new sock();
                 sPtr->setOutputGate(gate("udpOut"));
-                sPtr->connect(getIP(id+1),get_L0_L1_portnum(id));
+                sPtr->setTimeToLive(8);
+                sPtr->connect(getL1Group(),get_L0_L1_group_portnum());
 
                 outSockets.push_back(sPtr);
             }
+            else
+            {
+                for(uint id=0; id<8; id++)
+                {
+                    auto sPtr = new sock();
+                    sPtr->setOutputGate(gate("udpOut"));
+                    sPtr->connect(getIP(id+1),get_L0_L1_portnum(id));
+
+                    outSockets.push_back(sPtr);
+                }
+            }
 
             selfMsg = new cMessage("scheduler");
         }
@@ -168,12 +188,10 @@ Sensor::~Sensor()
         if(selfMsg) { cancelEvent(selfMsg); }
 
         delete  selfMsg;
-
-        image.close();
 }
 
 Sensor::Sensor()
-:   iterCnt(0), numSamples(0), ts(0.0), wcet(0.0), period(0.0)
+:   iterCnt(0), numSamples(0), tileWidth(0), gridWidth(0), encoding(BITMAP), image(nullptr), ts(0.0), wcet(0.0), period(0.0), images(nullptr)
 {}
 
 void    Sensor::handleNodeCrash()
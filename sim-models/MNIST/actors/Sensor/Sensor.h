@@ -17,6 +17,7 @@
 #define MNIST_SENSOR_H
 
 #include "../include/typedefs.h"
+#include "../include/idxFile.h"
 
 class INET_API Sensor : public inet::ApplicationBase
 {
@@ -25,11 +26,14 @@ class INET_API Sensor : public inet::ApplicationBase
     enum            SelfMsgKinds { POP=1, PUSH };
 
     int             iterCnt, numSamples;
-    int             d[IN_WIDTH + 1][IN_WIDTH + 1];
+    uint            tileWidth, gridWidth;
+    tileEncoding    encoding;
+    const uint8_t*  image;              // current sample, IN_WIDTH x IN_WIDTH row first (see idxFile)
     double          ts, wcet, period;
     cMessage*       selfMsg;
     arr<sock*>      outSockets;
-    std::ifstream   image;
+    arr<uint>       samples;            // image of every iteration
+    const idxFile*  images;
 
     void            sendVal();
     void            setOutVal();
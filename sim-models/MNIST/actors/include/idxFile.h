@@ -0,0 +1,164 @@
+#ifndef MNIST_IDX_FILE_H
+#define MNIST_IDX_FILE_H
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+    Read-only view of an IDX file (e.g. inputs/t10k-images.idx3-ubyte), mapped into memory once per
+    process and shared by all actors that read it.
+
+    The header is checked when the file is opened: two zero bytes, the data type (only unsigned
+    bytes, 0x08, are supported), the number of dimensions and one big endian uint32 per dimension.
+    The first dimension counts the items, the others give the shape of one item, which has to be
+    the one the caller expects (e.g. { 28, 28 } for images, {} for labels). item(i) points straight
+    into the mapping, so reading a sample copies nothing and any sample can be read at any time.
+*/
+
+class   idxFile
+{
+        public:
+
+        static  const idxFile&  get(const std::string& path2file, const std::vector<unsigned int>& itemShape)
+        {
+                    static std::map<std::string,std::unique_ptr<idxFile>> registry;
+
+                    auto& entry = registry[path2file];
+
+                    if(!entry)
+                        entry.reset(new idxFile(path2file));
+
+                    if(entry->shape != itemShape)
+                    {
+                        std::cout << path2file << " does not hold items of the expected size" << std::endl;
+                        exit(1);
+                    }
+
+                    return *entry;
+        }
+
+        unsigned int    numItems()  const   { return count; }
+        unsigned int    itemSize()  const   { return size; }
+
+        const uint8_t*  item(unsigned int idx)  const   { return data + ((size_t)idx*size); }
+
+        /* images and labels are paired by index, so both files have to hold the same number of items */
+        void    checkPairedWith(const idxFile& other)  const
+        {
+                    if(count != other.count)
+                    {
+                        std::cout << path << " holds " << count << " items but " << other.path << " holds " << other.count << std::endl;
+                        exit(1);
+                    }
+        }
+
+        /*
+            Items read by a run of "numSamples" samples: "firstSample" onwards in file order, or in
+            the order of a permutation drawn from "seed" if "shuffle" is set. Wraps around at the end
+            of the file, and every actor asking with the same arguments gets the same order.
+        */
+        std::vector<unsigned int>   order(unsigned int firstSample, unsigned int numSamples, bool shuffle, unsigned int seed)  const
+        {
+                    std::vector<unsigned int> perm(count), samples(numSamples);
+
+                    for(unsigned int i=0; i<count; i++)
+                        perm[i] = i;
+
+                    if(shuffle)
+                    {
+                        std::mt19937 rng(seed);
+
+                        // Fisher-Yates
+                        for(unsigned int i=count-1; i>0; i--)
+                            std::swap(perm[i], perm[std::uniform_int_distribution<size_t>(0, i)(rng)]);
+                    }
+
+                    for(unsigned int i=0; i<numSamples; i++)
+                        samples[i] = perm[(firstSample+i) % count];
+
+                    return samples;
+        }
+
+        ~idxFile()
+        {
+                    munmap(base, length);
+        }
+
+        private:
+
+        idxFile(const std::string& path2file)
+        : path(path2file), count(0), size(1)
+        {
+                    int fd = open(path2file.c_str(), O_RDONLY);
+                    struct stat st;
+
+                    if((fd < 0) || (fstat(fd, &st) != 0))
+                    {
+                        std::cout << "Unable to open file " << path2file << std::endl;
+                        exit(3);
+                    }
+
+                    length = st.st_size;
+                    base = (length > 0)? mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+                    close(fd);
+
+                    if(base == MAP_FAILED)
+                    {
+                        std::cout << "Unable to map file " << path2file << std::endl;
+                        exit(3);
+                    }
+
+                    const uint8_t* bytes = static_cast<const uint8_t*>(base);
+                    unsigned int ndims = (length >= 4)? bytes[3] : 0;
+
+                    if((length < 4) || (bytes[0] != 0) || (bytes[1] != 0) || (bytes[2] != 0x08) || (ndims == 0) || (length < 4+(4*ndims)))
+                    {
+                        std::cout << path2file << " is not an IDX file of unsigned bytes" << std::endl;
+                        exit(1);
+                    }
+
+                    for(unsigned int d=0; d<ndims; d++)
+                    {
+                        const uint8_t* p = bytes + 4 + (4*d);
+                        unsigned int dim = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+
+                        if(d == 0)
+                        {
+                            count = dim;
+                        }
+                        else
+                        {
+                            shape.push_back(dim);
+                            size *= dim;
+                        }
+                    }
+
+                    data = bytes + 4 + (4*ndims);
+
+                    if((count == 0) || (length - (4+(4*ndims)) < (size_t)count*size))
+                    {
+                        std::cout << path2file << " is shorter than its header says" << std::endl;
+                        exit(1);
+                    }
+        }
+
+        std::string     path;
+        void*           base;
+        size_t          length;
+        unsigned int    count, size;
+        std::vector<unsigned int>   shape;
+        const uint8_t*  data;
+};
+
+#endif
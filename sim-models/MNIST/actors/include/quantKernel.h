@@ -0,0 +1,115 @@
+#ifndef MNIST_QUANT_KERNEL_H
+#define MNIST_QUANT_KERNEL_H
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MNIST_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+/*
+    Integer kernels of the quantized mode.
+
+    Weights are int8 with one scale per output neuron (see weightStore::quantLayer1/2()), hidden
+    neurons are sent as round(ACT_MAX*value) since the sigmoid keeps them in [0,1]. Both stay
+    within [-127,127], so sums of 16 products fit into int16 and the pairs of _mm_maddubs_epi16()
+    can not saturate. As in tileKernel.h, the AVX2 and SSSE3 paths are compiled for their target only
+    and picked once at run time. Sums are exact integers, so every path gives the same result.
+*/
+
+#define ACT_MAX     127
+
+inline  int8_t  quantizeActivation(double value)
+{
+        return (int8_t)lround(value*ACT_MAX);
+}
+
+/*
+    acc[h] += sum of w[(o*16)+h] for every pixel "o" set in "bits", i.e. accumulateBits() on int8
+    weights. Rows are added in int16, which holds up to 64 pixels of 127, and the sums of the tiles in
+    int32, so the scale of each neuron is applied once to the sum of all of them.
+*/
+
+inline  void    sumRowsPlain(const int8_t* w, uint64_t bits, int16_t* sum)
+{
+        for(; bits; bits &= bits-1)
+        {
+            const int8_t* row = w + (16*__builtin_ctzll(bits));
+
+            for(unsigned int h=0; h<16; h++)
+                sum[h] += row[h];
+        }
+}
+
+#ifdef MNIST_X86_KERNELS
+__attribute__((target("avx2")))
+inline  void    sumRowsAvx2(const int8_t* w, uint64_t bits, int16_t* sum)
+{
+        __m256i s = _mm256_setzero_si256();
+
+        for(; bits; bits &= bits-1)
+            s = _mm256_add_epi16(s, _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(w + (16*__builtin_ctzll(bits))))));
+
+        _mm256_storeu_si256((__m256i*)sum, s);
+}
+#endif
+
+inline  void    accumulateBitsQ(const int8_t* w, uint64_t bits, int32_t* acc)
+{
+#ifdef MNIST_X86_KERNELS
+        static const bool avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+#else
+        static const bool avx2 = false;
+#endif
+        int16_t sum[16] = { 0 };
+
+#ifdef MNIST_X86_KERNELS
+        if(avx2)
+            sumRowsAvx2(w, bits, sum);
+        else
+#endif
+            sumRowsPlain(w, bits, sum);
+
+        for(unsigned int h=0; h<16; h++)
+            acc[h] += sum[h];
+}
+
+/* sum over i<16 of a[i]*w[i], with "a" in [0,ACT_MAX] */
+inline  int32_t dotQ16Plain(const int8_t* a, const int8_t* w)
+{
+        int32_t sum = 0;
+
+        for(unsigned int i=0; i<16; i++)
+            sum += a[i] * w[i];
+
+        return sum;
+}
+
+#ifdef MNIST_X86_KERNELS
+__attribute__((target("ssse3")))
+inline  int32_t dotQ16Ssse3(const int8_t* a, const int8_t* w)
+{
+        __m128i s = _mm_maddubs_epi16(_mm_loadu_si128((const __m128i*)a), _mm_loadu_si128((const __m128i*)w));
+
+        s = _mm_madd_epi16(s, _mm_set1_epi16(1));
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4e));
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xb1));
+
+        return _mm_cvtsi128_si32(s);
+}
+#endif
+
+inline  int32_t dotQ16(const int8_t* a, const int8_t* w)
+{
+#ifdef MNIST_X86_KERNELS
+        static const bool ssse3 = (__builtin_cpu_init(), __builtin_cpu_supports("ssse3"));
+
+        if(ssse3)
+            return dotQ16Ssse3(a, w);
+#endif
+        return dotQ16Plain(a, w);
+}
+
+#endif
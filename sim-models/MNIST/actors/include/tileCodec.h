@@ -0,0 +1,110 @@
+#ifndef MNIST_TILE_CODEC_H
+#define MNIST_TILE_CODEC_H
+
+#include <string>
+#include <cstdint>
+#include <cstring>
+
+/*
+    Encodings of a tile sent by the Sensor, pixels are values in [0,1] in row first order:
+      - bitmap  : one bit per pixel (set if the pixel is not 0), bit o of byte o/8 is pixel o
+      - uint8   : round(255*value)
+      - float16 : IEEE half precision, truncated, subnormals flushed to zero
+      - double  : as is
+    All in host byte order, a token's byte length is the encoded size plus its sequence number.
+
+    FCLayer1 works on binary pixels (see accumulateBits()), so decoding a tile gives the bitmap of
+    its non-zero pixels, which is exact for the binarized images of the Sensor.
+*/
+
+enum    tileEncoding { BITMAP = 0, UINT8, FLOAT16, DOUBLE };
+
+/* maps the name used in .ini files to an encoding, returns false if the name is unknown */
+inline  bool    parseEncoding(const std::string& name, tileEncoding& encoding)
+{
+        if( name == "bitmap" )          { encoding = BITMAP; }
+        else if( name == "uint8" )      { encoding = UINT8; }
+        else if( name == "float16" )    { encoding = FLOAT16; }
+        else if( name == "double" )     { encoding = DOUBLE; }
+        else                            { return false; }
+
+        return true;
+}
+
+inline  size_t  encodedSize(tileEncoding encoding, unsigned int pixels)
+{
+        switch(encoding)
+        {
+            case BITMAP:    return (pixels+7)/8;
+            case UINT8:     return pixels;
+            case FLOAT16:   return 2*pixels;
+            default:        return sizeof(double)*pixels;
+        }
+}
+
+inline  uint16_t    toHalf(float value)
+{
+        uint32_t x;
+        memcpy(&x, &value, sizeof(x));
+
+        uint16_t sign = (x >> 16) & 0x8000;
+        int exponent = (int)((x >> 23) & 0xff) - 127 + 15;
+
+        if(exponent <= 0)
+            return sign;
+
+        if(exponent >= 31)
+            return sign | 0x7c00;
+
+        return sign | (exponent << 10) | ((x & 0x7fffff) >> 13);
+}
+
+/* "out" must hold encodedSize(encoding, count) bytes, returns that size */
+inline  size_t  encodeTile(tileEncoding encoding, const double* pixels, unsigned int count, uint8_t* out)
+{
+        size_t size = encodedSize(encoding, count);
+
+        memset(out, 0, size);
+
+        for(unsigned int o=0; o<count; o++)
+        {
+            switch(encoding)
+            {
+                case BITMAP:
+                {
+                    if(pixels[o] != 0.0)
+                        out[o/8] |= (1 << (o%8));
+                    break;
+                }
+                case UINT8:     { out[o] = (uint8_t)(pixels[o]*255.0 + 0.5); break; }
+                case FLOAT16:   { uint16_t h = toHalf(pixels[o]); memcpy(&out[2*o], &h, 2); break; }
+                case DOUBLE:    { memcpy(&out[sizeof(double)*o], &pixels[o], sizeof(double)); break; }
+            }
+        }
+
+        return size;
+}
+
+/* bit o of bits[o/64] is set for every non-zero pixel "o", "bits" must hold (count+63)/64 words */
+inline  void    decodeTile(tileEncoding encoding, const uint8_t* in, unsigned int count, uint64_t* bits)
+{
+        memset(bits, 0, sizeof(uint64_t)*((count+63)/64));
+
+        for(unsigned int o=0; o<count; o++)
+        {
+            bool set = false;
+
+            switch(encoding)
+            {
+                case BITMAP:    { set = (in[o/8] >> (o%8)) & 1; break; }
+                case UINT8:     { set = (in[o] != 0); break; }
+                case FLOAT16:   { uint16_t h; memcpy(&h, in + (2*o), 2); set = ((h & 0x7fff) != 0); break; }
+                case DOUBLE:    { double v; memcpy(&v, in + (sizeof(double)*o), sizeof(double)); set = (v != 0.0); break; }
+            }
+
+            if(set)
+                bits[o/64] |= ((uint64_t)1 << (o%64));
+        }
+}
+
+#endif
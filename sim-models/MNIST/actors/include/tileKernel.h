@@ -0,0 +1,88 @@
+#ifndef MNIST_TILE_KERNEL_H
+#define MNIST_TILE_KERNEL_H
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MNIST_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+/*
+    acc[h] += w[(o*16)+h] for every pixel "o" set in "bits", for the 16 hidden neurons of one FCLayer1
+    partition, so the products of binary pixels become masked sums of weight rows and only the set
+    pixels are visited.
+
+    "w" is the block of one tile (see weightStore::tiledLayer1()), its rows must be 64 byte aligned.
+    AVX-512 keeps the 16 sums in two registers and AVX2 in four. Both are compiled for their target
+    only and picked once at run time from what the CPU supports, so the binary runs on any x86-64.
+    Every path adds the rows in the same order without FMA, so all of them give the same sums.
+*/
+
+inline  void    accumulateBitsPlain(const double* w, uint64_t bits, double* acc)
+{
+        for(; bits; bits &= bits-1)
+        {
+            const double* row = w + (16*__builtin_ctzll(bits));
+
+            for(unsigned int h=0; h<16; h++)
+                acc[h] += row[h];
+        }
+}
+
+#ifdef MNIST_X86_KERNELS
+__attribute__((target("avx512f")))
+inline  void    accumulateBitsAvx512(const double* w, uint64_t bits, double* acc)
+{
+        __m512d a0 = _mm512_loadu_pd(acc), a1 = _mm512_loadu_pd(acc+8);
+
+        for(; bits; bits &= bits-1)
+        {
+            const double* row = w + (16*__builtin_ctzll(bits));
+
+            a0 = _mm512_add_pd(a0, _mm512_load_pd(row));
+            a1 = _mm512_add_pd(a1, _mm512_load_pd(row+8));
+        }
+
+        _mm512_storeu_pd(acc, a0);
+        _mm512_storeu_pd(acc+8, a1);
+}
+
+__attribute__((target("avx2")))
+inline  void    accumulateBitsAvx2(const double* w, uint64_t bits, double* acc)
+{
+        __m256d a0 = _mm256_loadu_pd(acc), a1 = _mm256_loadu_pd(acc+4), a2 = _mm256_loadu_pd(acc+8), a3 = _mm256_loadu_pd(acc+12);
+
+        for(; bits; bits &= bits-1)
+        {
+            const double* row = w + (16*__builtin_ctzll(bits));
+
+            a0 = _mm256_add_pd(a0, _mm256_load_pd(row));
+            a1 = _mm256_add_pd(a1, _mm256_load_pd(row+4));
+            a2 = _mm256_add_pd(a2, _mm256_load_pd(row+8));
+            a3 = _mm256_add_pd(a3, _mm256_load_pd(row+12));
+        }
+
+        _mm256_storeu_pd(acc, a0);
+        _mm256_storeu_pd(acc+4, a1);
+        _mm256_storeu_pd(acc+8, a2);
+        _mm256_storeu_pd(acc+12, a3);
+}
+#endif
+
+inline  void    accumulateBits(const double* w, uint64_t bits, double* acc)
+{
+#ifdef MNIST_X86_KERNELS
+        static const bool avx512 = (__builtin_cpu_init(), __builtin_cpu_supports("avx512f"));
+        static const bool avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+
+        if(avx512)
+            accumulateBitsAvx512(w, bits, acc);
+        else if(avx2)
+            accumulateBitsAvx2(w, bits, acc);
+        else
+#endif
+            accumulateBitsPlain(w, bits, acc);
+}
+
+#endif
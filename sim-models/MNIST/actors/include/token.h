@@ -1,55 +1,42 @@
 #ifndef MNIST_TOKEN_H
 #define MNIST_TOKEN_H
 
-struct  nnData      { double array[16]; };
+#include <cstdint>
+#include "../../../common/token.h"
 
-class   token
-{
-        public:
-
-        bool        isEmpty() const { return !isInitialized; }
-
-        nnData      getData()
-        {
-                    assert(!isEmpty());
-
-                    isRead = true;
-
-                    return data;
-        }
-
-        void        copy(nnData _data)
-        {
-                    assert(isEmpty());
-
-                    if(!isRead)
-                    {
-                        data = _data;
+// bitmap words of the largest tile, 28 x 28 pixels
+#define TILE_WORDS  13
 
-                        isInitialized = true;
-                    }
-                    #ifdef ALREADY
-                    else
-                    {
-                        std::cout << "ignoring update to already consumed token" << std::endl;
-                    }
-                    #endif
-        }
+// bytes of the largest encoded tile a token carries, e.g. a 28 x 28 tile as uint8 or a 7 x 7 one as double
+#define TILE_BYTES  (TILE_WORDS*64)
 
-        token(uint _seqN, nnData _data)
-        : seqN(_seqN), isRead(false), isInitialized(true), data(_data)
-        {}
-
-        token(uint _seqN)
-        : seqN(_seqN), isRead(false), isInitialized(false)
-        {}
-
-        const uint  seqN;
+/*
+    Hidden neurons of one FCLayer1 partition, "quant" holds them in the quantized mode
+    (round(127*value), see quantKernel.h).
+*/
+struct  nnData
+{
+        double          array[16];
+        int8_t          quant[16];
+};
 
-        private:
+/*
+    Tile sent by the Sensor, the first "tileSize" bytes of "tile" hold its "pixels" pixels encoded as
+    "encoding" (see tileCodec.h). The tile is inline so packets stay trivially copyable, it is kept
+    out of nnData so that the hidden neurons do not carry its TILE_BYTES.
+*/
+struct  tileData
+{
+        uint8_t         encoding;
+        uint16_t        pixels;
+        uint16_t        tileSize;
+        uint8_t         tile[TILE_BYTES];
+};
 
-        bool        isRead, isInitialized;
-        nnData      data;
+/* what FCLayer1 keeps of a tile, bit o of bits[o/64] is pixel o */
+struct  tileBits
+{
+        uint64_t        bits[TILE_WORDS];
 };
 
 #endif
@@ -2,6 +2,7 @@
 #define MNIST_TYPEDEF_H
 
 #include <map>
+#include <array>
 #include <set>
 #include <vector>
 #include <fstream>
@@ -9,7 +10,10 @@
 #include <algorithm>
 #include <inet/applications/base/ApplicationBase.h>
 #include <inet/transportlayer/contract/udp/UDPSocket.h>
-#include "udpBuffer.h"
+#include "../../nnPacket_m.h"
+#include "../../../common/udpBuffer.h"
+#include "../../../common/batchMeans.h"
+#include "tileCodec.h"
 
 template<class T>
 using   arr = std::vector<T>;
@@ -19,16 +23,19 @@ using   uint = unsigned int;
 using   sock = inet::UDPSocket;
 using   strMap = std::map<str2,str2>;
 using   addrMap = std::map<str2,inet::L3Address>;
+using   nnBuffer = udpBuffer<nnData>;
+using   tileBuffer = udpBuffer<tileBits>;
 
 int     getL1Id(uint);
 uint    get_L0_L1_portnum(uint);
 uint    get_L1_L2_portnum(uint);
+uint    get_L0_L1_group_portnum();
+uint    checkTileWidth(int);
 double  sigmoid(double);
 inet::L3Address getIP(uint);
+inet::L3Address getL1Group();
 
 #define IN_WIDTH    28
-#define TILE_WIDTH  4
-#define GRID_WIDTH  (IN_WIDTH/TILE_WIDTH)
 
 // n1 = Number of input neurons
 #define N1  (IN_WIDTH*IN_WIDTH)
@@ -1,9 +1,11 @@
 #include "typedefs.h"
 #include <cstdlib>
+#include <iostream>
 #include <inet/networklayer/common/L3Address.h>
 
 #define L0_L1_BASE_PORTNUM  10000
 #define L1_L2_BASE_PORTNUM  10010
+#define L0_L1_GROUP         "239.254.0.1"   // administratively scoped, see configIP.xml for its route through the cloud
 
 double  sigmoid(double x)
 {
@@ -21,4 +23,20 @@ inet::L3Address getIP(uint idx)
 uint    get_L0_L1_portnum(uint id)  { return L0_L1_BASE_PORTNUM+id; }
 uint    get_L1_L2_portnum(uint id)  { return L1_L2_BASE_PORTNUM+id; }
 
+/* multicast group of the eight FCLayer1 partitions, a datagram has one port so they share 10008 */
+inet::L3Address getL1Group()        { return inet::L3Address(L0_L1_GROUP); }
+uint    get_L0_L1_group_portnum()   { return L0_L1_BASE_PORTNUM+8; }
+
 int     getL1Id(uint l1_l2_portnum) { return (l1_l2_portnum-L1_L2_BASE_PORTNUM); }
+
+/* images are split into (IN_WIDTH/tileWidth)^2 square tiles, so the width has to divide IN_WIDTH */
+uint    checkTileWidth(int tileWidth)
+{
+        if((tileWidth <= 0) || (IN_WIDTH%tileWidth != 0))
+        {
+            std::cout << "tileWidth " << tileWidth << " does not divide the image width " << IN_WIDTH << std::endl;
+            exit(1);
+        }
+
+        return tileWidth;
+}
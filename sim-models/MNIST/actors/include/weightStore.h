@@ -0,0 +1,300 @@
+#ifndef MNIST_WEIGHT_STORE_H
+#define MNIST_WEIGHT_STORE_H
+
+#include <map>
+#include <memory>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "typedefs.h"
+
+/*
+    Read-only weights of both layers, shared by all actors of the process.
+
+    The text model (e.g. inputs/model-neural-network.dat) is converted once to "<model>.bin" next to
+    it, which is rebuilt whenever the text file is newer, and the binary file is mapped into memory.
+    Its layout gives every FCLayer1 partition one contiguous block:
+      - 64 byte header (magic, N1, N2, N3, number of partitions)
+      - layer 1, partition-major: block "p" holds N1 rows of the N2/parts hidden neurons of partition "p"
+      - layer 2, row-major: N2 rows of N3 output neurons
+    Both sections start at a multiple of 64 bytes.
+
+    FCLayer1 multiplies each tile it receives with its own weights, so layer 1 is also offered in
+    tile-major order: per partition and tile width, tile "t" is a (tileWidth^2) x 16 block of (pixel in
+    tile, hidden neuron), built on first use and kept 64 byte aligned.
+
+    The quantized mode uses int8 copies of both layers, also built on first use: every output
+    neuron (hidden neuron of layer 1, output neuron of layer 2) gets its own scale, max|w|/127.
+*/
+
+#define WEIGHT_PARTS    8
+#define PART_WIDTH      (N2/WEIGHT_PARTS)
+
+class   weightStore
+{
+        public:
+
+        /* int8 weights, "w" times "scale" of the output neuron gives the original weight */
+        struct  quantLayer
+        {
+                std::vector<int8_t>     w;
+                std::vector<double>     scale;
+        };
+
+        static  const weightStore&  get(const std::string& path2model)
+        {
+                    static std::map<std::string,std::unique_ptr<weightStore>> registry;
+
+                    auto& entry = registry[path2model];
+
+                    if(!entry)
+                        entry.reset(new weightStore(path2model));
+
+                    return *entry;
+        }
+
+        /* weights of partition "part", element [(input*PART_WIDTH)+hidden] */
+        const double*   layer1(unsigned int part)   const   { return w1 + (part*N1*PART_WIDTH); }
+
+        /* weights of partition "part" by tile, element [(((tile*tileWidth*tileWidth)+pixel)*PART_WIDTH)+hidden] */
+        const double*   tiledLayer1(unsigned int part, unsigned int tileWidth)  const
+        {
+                    auto& entry = tiled[std::make_pair(part, tileWidth)];
+
+                    if(!entry)
+                    {
+                        void* mem = nullptr;
+
+                        if(posix_memalign(&mem, 64, sizeof(double)*N1*PART_WIDTH) != 0)
+                        {
+                            std::cout << "Unable to allocate tiled weights" << std::endl;
+                            exit(3);
+                        }
+
+                        entry.reset(static_cast<double*>(mem));
+                        tile(layer1(part), tileWidth, entry.get());
+                    }
+
+                    return entry.get();
+        }
+
+        /* weights of layer 2, element [(hidden*N3)+output] */
+        const double*   layer2()                    const   { return w2; }
+
+        /* tiledLayer1() in int8, scale[hidden], without keeping the tiled doubles */
+        const quantLayer&   quantLayer1(unsigned int part, unsigned int tileWidth)  const
+        {
+                    auto& entry = quant1[std::make_pair(part, tileWidth)];
+
+                    if(entry.w.empty())
+                    {
+                        std::vector<double> t(N1*PART_WIDTH);
+
+                        tile(layer1(part), tileWidth, t.data());
+                        quantize(t.data(), N1, PART_WIDTH, entry);
+                    }
+
+                    return entry;
+        }
+
+        /* layer2() in int8 and transposed, element [(output*N2)+hidden] and scale[output] */
+        const quantLayer&   quantLayer2()           const
+        {
+                    if(quant2.w.empty())
+                    {
+                        std::vector<double> t(N2*N3);
+
+                        for(unsigned int i=0; i<N2; i++)
+                            for(unsigned int j=0; j<N3; j++)
+                                t[(j*N2)+i] = w2[(i*N3)+j];
+
+                        quantize(t.data(), N3, N2, quant2, true);
+                    }
+
+                    return quant2;
+        }
+
+        ~weightStore()
+        {
+                    munmap(base, length);
+        }
+
+        private:
+
+        struct  header
+        {
+                char            magic[8];
+                uint32_t        n1, n2, n3, parts;
+                char            pad[40];
+        };
+
+        static  const   size_t  W1_OFFSET = sizeof(header);
+        static  const   size_t  W2_OFFSET = W1_OFFSET + (sizeof(double)*N1*N2);
+        static  const   size_t  FILE_SIZE = W2_OFFSET + (sizeof(double)*N2*N3);
+
+        weightStore(const std::string& path2model)
+        {
+                    std::string path2bin = path2model + ".bin";
+
+                    if(isStale(path2model, path2bin))
+                        convert(path2model, path2bin);
+
+                    int fd = open(path2bin.c_str(), O_RDONLY);
+
+                    if(fd < 0)
+                    {
+                        std::cout << "Unable to open file " << path2bin << std::endl;
+                        exit(3);
+                    }
+
+                    length = FILE_SIZE;
+                    base = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+                    close(fd);
+
+                    if(base == MAP_FAILED)
+                    {
+                        std::cout << "Unable to map file " << path2bin << std::endl;
+                        exit(3);
+                    }
+
+                    const header* hdr = static_cast<const header*>(base);
+
+                    if(memcmp(hdr->magic, "MNISTW1", 8) || (hdr->n1 != N1) || (hdr->n2 != N2) || (hdr->n3 != N3) || (hdr->parts != WEIGHT_PARTS))
+                    {
+                        std::cout << path2bin << " does not match the network, remove it to convert " << path2model << " again" << std::endl;
+                        exit(1);
+                    }
+
+                    w1 = reinterpret_cast<const double*>(static_cast<const char*>(base) + W1_OFFSET);
+                    w2 = reinterpret_cast<const double*>(static_cast<const char*>(base) + W2_OFFSET);
+        }
+
+        static  bool    isStale(const std::string& path2model, const std::string& path2bin)
+        {
+                    struct stat txt, bin;
+
+                    if(stat(path2bin.c_str(), &bin) != 0)
+                        return true;
+
+                    if(stat(path2model.c_str(), &txt) != 0)
+                        return false;
+
+                    return (bin.st_size != (off_t)FILE_SIZE) || (txt.st_mtime > bin.st_mtime);
+        }
+
+        /* parses the text model once, written to a temporary file first so readers never see half of it */
+        static  void    convert(const std::string& path2model, const std::string& path2bin)
+        {
+                    std::ifstream file(path2model.c_str(), std::ifstream::in);
+
+                    if(!file.is_open())
+                    {
+                        std::cout << "Unable to open file " << path2model << std::endl;
+                        exit(3);
+                    }
+
+                    std::vector<double> w1(N1*N2), w2(N2*N3);
+
+                    // Input layer - Hidden layer, stored by partition
+                    for(int i=0; i<N1; i++)
+                        for(int j=0; j<N2; j++)
+                            file >> w1[((j/PART_WIDTH)*N1*PART_WIDTH) + (i*PART_WIDTH) + (j%PART_WIDTH)];
+
+                    // Hidden layer - Output layer
+                    for(int i=0; i<N2; i++)
+                        for(int j=0; j<N3; j++)
+                            file >> w2[(i*N3)+j];
+
+                    if(file.fail())
+                    {
+                        std::cout << path2model << " holds fewer than " << (N1*N2)+(N2*N3) << " weights" << std::endl;
+                        exit(1);
+                    }
+
+                    header hdr;
+                    memset(&hdr, 0, sizeof(hdr));
+                    memcpy(hdr.magic, "MNISTW1", 8);
+                    hdr.n1 = N1;
+                    hdr.n2 = N2;
+                    hdr.n3 = N3;
+                    hdr.parts = WEIGHT_PARTS;
+
+                    std::string tmp = path2bin + "." + std::to_string(getpid());
+                    std::ofstream out(tmp.c_str(), std::ofstream::out | std::ofstream::binary);
+
+                    out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+                    out.write(reinterpret_cast<const char*>(w1.data()), sizeof(double)*w1.size());
+                    out.write(reinterpret_cast<const char*>(w2.data()), sizeof(double)*w2.size());
+                    out.close();
+
+                    if(out.fail() || (rename(tmp.c_str(), path2bin.c_str()) != 0))
+                    {
+                        std::cout << "Unable to write file " << path2bin << std::endl;
+                        exit(3);
+                    }
+        }
+
+        /* layer 1 weights "src" of one partition in the order of tiledLayer1() */
+        static  void    tile(const double* src, unsigned int tileWidth, double* dst)
+        {
+                    unsigned int gridWidth = IN_WIDTH/tileWidth;
+                    unsigned int pixels = tileWidth*tileWidth;
+
+                    for(unsigned int t=0; t<gridWidth*gridWidth; t++)
+                    {
+                        for(unsigned int o=0; o<pixels; o++)
+                        {
+                            unsigned int x = ((t%gridWidth)*tileWidth) + (o%tileWidth);
+                            unsigned int y = ((t/gridWidth)*tileWidth) + (o/tileWidth);
+
+                            memcpy(dst, src + (((IN_WIDTH*y)+x)*PART_WIDTH), sizeof(double)*PART_WIDTH);
+                            dst += PART_WIDTH;
+                        }
+                    }
+        }
+
+        /* "rows" x "cols" weights, one scale per column or, if "byRow", per row */
+        static  void    quantize(const double* w, unsigned int rows, unsigned int cols, quantLayer& q, bool byRow = false)
+        {
+                    q.w.resize(rows*cols);
+                    q.scale.assign(byRow? rows : cols, 0.0);
+
+                    for(unsigned int i=0; i<rows*cols; i++)
+                    {
+                        double& scale = q.scale[byRow? (i/cols) : (i%cols)];
+                        scale = std::max(scale, fabs(w[i])/127.0);
+                    }
+
+                    for(double& scale:q.scale)
+                        if(scale == 0.0)
+                            scale = 1.0;
+
+                    for(unsigned int i=0; i<rows*cols; i++)
+                        q.w[i] = (int8_t)lround(w[i] / q.scale[byRow? (i/cols) : (i%cols)]);
+        }
+
+        struct  freeDeleter
+        {
+                void            operator()(double* p) const     { free(p); }
+        };
+
+        void*           base;
+        size_t          length;
+        mutable std::map<std::pair<unsigned int,unsigned int>,std::unique_ptr<double,freeDeleter>>   tiled;
+        mutable std::map<std::pair<unsigned int,unsigned int>,quantLayer>   quant1;
+        mutable quantLayer  quant2;
+        const double*   w1;
+        const double*   w2;
+};
+
+#endif
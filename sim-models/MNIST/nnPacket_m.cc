@@ -477,4 +477,304 @@ void *nnPacketDescriptor::getFieldStructValuePointer(void *object, int field, in
     }
 }
 
+Register_Class(tilePacket)
+
+tilePacket::tilePacket(const char *name, short kind) : ::omnetpp::cPacket(name,kind)
+{
+    this->sequenceNumber = 0;
+}
+
+tilePacket::tilePacket(const tilePacket& other) : ::omnetpp::cPacket(other)
+{
+    copy(other);
+}
+
+tilePacket::~tilePacket()
+{
+}
+
+tilePacket& tilePacket::operator=(const tilePacket& other)
+{
+    if (this==&other) return *this;
+    ::omnetpp::cPacket::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void tilePacket::copy(const tilePacket& other)
+{
+    this->sequenceNumber = other.sequenceNumber;
+    this->payload = other.payload;
+}
+
+void tilePacket::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::omnetpp::cPacket::parsimPack(b);
+    doParsimPacking(b,this->sequenceNumber);
+    doParsimPacking(b,this->payload);
+}
+
+void tilePacket::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::omnetpp::cPacket::parsimUnpack(b);
+    doParsimUnpacking(b,this->sequenceNumber);
+    doParsimUnpacking(b,this->payload);
+}
+
+long tilePacket::getSequenceNumber() const
+{
+    return this->sequenceNumber;
+}
+
+void tilePacket::setSequenceNumber(long sequenceNumber)
+{
+    this->sequenceNumber = sequenceNumber;
+}
+
+tileData& tilePacket::getPayload()
+{
+    return this->payload;
+}
+
+void tilePacket::setPayload(const tileData& payload)
+{
+    this->payload = payload;
+}
+
+class tilePacketDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertynames;
+  public:
+    tilePacketDescriptor();
+    virtual ~tilePacketDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyname) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyname) const override;
+    virtual int getFieldArraySize(void *object, int field) const override;
+
+    virtual const char *getFieldDynamicTypeString(void *object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(void *object, int field, int i) const override;
+    virtual bool setFieldValueAsString(void *object, int field, int i, const char *value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual void *getFieldStructValuePointer(void *object, int field, int i) const override;
+};
+
+Register_ClassDescriptor(tilePacketDescriptor)
+
+tilePacketDescriptor::tilePacketDescriptor() : omnetpp::cClassDescriptor("tilePacket", "omnetpp::cPacket")
+{
+    propertynames = nullptr;
+}
+
+tilePacketDescriptor::~tilePacketDescriptor()
+{
+    delete[] propertynames;
+}
+
+bool tilePacketDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<tilePacket *>(obj)!=nullptr;
+}
+
+const char **tilePacketDescriptor::getPropertyNames() const
+{
+    if (!propertynames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+        const char **basenames = basedesc ? basedesc->getPropertyNames() : nullptr;
+        propertynames = mergeLists(basenames, names);
+    }
+    return propertynames;
+}
+
+const char *tilePacketDescriptor::getProperty(const char *propertyname) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    return basedesc ? basedesc->getProperty(propertyname) : nullptr;
+}
+
+int tilePacketDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    return basedesc ? 2+basedesc->getFieldCount() : 2;
+}
+
+unsigned int tilePacketDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldTypeFlags(field);
+        field -= basedesc->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,
+        FD_ISCOMPOUND,
+    };
+    return (field>=0 && field<2) ? fieldTypeFlags[field] : 0;
+}
+
+const char *tilePacketDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldName(field);
+        field -= basedesc->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "sequenceNumber",
+        "payload",
+    };
+    return (field>=0 && field<2) ? fieldNames[field] : nullptr;
+}
+
+int tilePacketDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    int base = basedesc ? basedesc->getFieldCount() : 0;
+    if (fieldName[0]=='s' && strcmp(fieldName, "sequenceNumber")==0) return base+0;
+    if (fieldName[0]=='p' && strcmp(fieldName, "payload")==0) return base+1;
+    return basedesc ? basedesc->findField(fieldName) : -1;
+}
+
+const char *tilePacketDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldTypeString(field);
+        field -= basedesc->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "long",
+        "tileData",
+    };
+    return (field>=0 && field<2) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **tilePacketDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldPropertyNames(field);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *tilePacketDescriptor::getFieldProperty(int field, const char *propertyname) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldProperty(field, propertyname);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int tilePacketDescriptor::getFieldArraySize(void *object, int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldArraySize(object, field);
+        field -= basedesc->getFieldCount();
+    }
+    tilePacket *pp = (tilePacket *)object; (void)pp;
+    switch (field) {
+        default: return 0;
+    }
+}
+
+const char *tilePacketDescriptor::getFieldDynamicTypeString(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldDynamicTypeString(object,field,i);
+        field -= basedesc->getFieldCount();
+    }
+    tilePacket *pp = (tilePacket *)object; (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string tilePacketDescriptor::getFieldValueAsString(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldValueAsString(object,field,i);
+        field -= basedesc->getFieldCount();
+    }
+    tilePacket *pp = (tilePacket *)object; (void)pp;
+    switch (field) {
+        case 0: return long2string(pp->getSequenceNumber());
+        case 1: {std::stringstream out; out << pp->getPayload(); return out.str();}
+        default: return "";
+    }
+}
+
+bool tilePacketDescriptor::setFieldValueAsString(void *object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->setFieldValueAsString(object,field,i,value);
+        field -= basedesc->getFieldCount();
+    }
+    tilePacket *pp = (tilePacket *)object; (void)pp;
+    switch (field) {
+        case 0: pp->setSequenceNumber(string2long(value)); return true;
+        default: return false;
+    }
+}
+
+const char *tilePacketDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldStructName(field);
+        field -= basedesc->getFieldCount();
+    }
+    switch (field) {
+        case 1: return omnetpp::opp_typename(typeid(tileData));
+        default: return nullptr;
+    };
+}
+
+void *tilePacketDescriptor::getFieldStructValuePointer(void *object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *basedesc = getBaseClassDescriptor();
+    if (basedesc) {
+        if (field < basedesc->getFieldCount())
+            return basedesc->getFieldStructValuePointer(object, field, i);
+        field -= basedesc->getFieldCount();
+    }
+    tilePacket *pp = (tilePacket *)object; (void)pp;
+    switch (field) {
+        case 1: return (void *)(&pp->getPayload()); break;
+        default: return nullptr;
+    }
+}
+
 
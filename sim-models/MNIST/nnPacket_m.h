@@ -23,7 +23,7 @@
 // }}
 
 /**
- * Class generated from <tt>nnPacket.msg:23</tt> by nedtool.
+ * Class generated from <tt>nnPacket.msg:24</tt> by nedtool.
  * <pre>
  * packet nnPacket
  * {
@@ -65,6 +65,49 @@ class nnPacket : public ::omnetpp::cPacket
 inline void doParsimPacking(omnetpp::cCommBuffer *b, const nnPacket& obj) {obj.parsimPack(b);}
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, nnPacket& obj) {obj.parsimUnpack(b);}
 
+/**
+ * Class generated from <tt>nnPacket.msg:30</tt> by nedtool.
+ * <pre>
+ * packet tilePacket
+ * {
+ *     long sequenceNumber;
+ *     tileData payload;
+ * }
+ * </pre>
+ */
+class tilePacket : public ::omnetpp::cPacket
+{
+  protected:
+    long sequenceNumber;
+    tileData payload;
+
+  private:
+    void copy(const tilePacket& other);
+
+  protected:
+    // protected and unimplemented operator==(), to prevent accidental usage
+    bool operator==(const tilePacket&);
+
+  public:
+    tilePacket(const char *name=nullptr, short kind=0);
+    tilePacket(const tilePacket& other);
+    virtual ~tilePacket();
+    tilePacket& operator=(const tilePacket& other);
+    virtual tilePacket *dup() const override {return new tilePacket(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    // field getter/setter methods
+    virtual long getSequenceNumber() const;
+    virtual void setSequenceNumber(long sequenceNumber);
+    virtual tileData& getPayload();
+    virtual const tileData& getPayload() const {return const_cast<tilePacket*>(this)->getPayload();}
+    virtual void setPayload(const tileData& payload);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const tilePacket& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, tilePacket& obj) {obj.parsimUnpack(b);}
+
 
 #endif // ifndef __NNPACKET_M_H
 
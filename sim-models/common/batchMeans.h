@@ -0,0 +1,99 @@
+#ifndef COMMON_BATCH_MEANS_H
+#define COMMON_BATCH_MEANS_H
+
+#include <cmath>
+#include <vector>
+
+/*
+    Confidence interval of the mean of a correlated series (e.g. per-iteration noise power), by the
+    method of batch means.
+
+    Observations are averaged in batches of "batchSize" and the batch means are treated as
+    independent. Once 2*minBatches batches exist, neighbouring ones are merged and the batch size
+    doubles, so memory stays bounded and batches grow with the run, which weakens their correlation.
+    The interval is the 95% one of Student's t with the number of complete batches minus one degrees
+    of freedom.
+*/
+
+class   batchMeans
+{
+        public:
+
+        batchMeans(unsigned int _batchSize, unsigned int _minBatches)
+        : batchSize(_batchSize? _batchSize : 1), minBatches(_minBatches < 2? 2 : _minBatches), count(0), sum(0.0)
+        {}
+
+        void            observe(double x)
+        {
+                    sum += x;
+
+                    if(++count < batchSize)
+                        return;
+
+                    means.push_back(sum/count);
+                    count = 0;
+                    sum = 0.0;
+
+                    if(means.size() == 2*minBatches)
+                    {
+                        for(unsigned int i=0; i<minBatches; i++)
+                            means[i] = 0.5*(means[2*i] + means[(2*i)+1]);
+
+                        means.resize(minBatches);
+                        batchSize *= 2;
+                    }
+        }
+
+        unsigned int    batches()   const   { return means.size(); }
+
+        /* mean of the complete batches */
+        double          mean()      const
+        {
+                    double m = 0.0;
+
+                    for(double b:means)
+                        m += b;
+
+                    return means.empty()? 0.0 : m/means.size();
+        }
+
+        double          halfWidth() const
+        {
+                    unsigned int k = means.size();
+
+                    if(k < 2)
+                        return INFINITY;
+
+                    double m = mean(), var = 0.0;
+
+                    for(double b:means)
+                        var += (b-m)*(b-m);
+
+                    var /= (k-1);
+
+                    return tQuantile(k-1) * sqrt(var/k);
+        }
+
+        /* half width within "precision" times the mean, after at least "minBatches" batches */
+        bool            converged(double precision)  const
+        {
+                    return (means.size() >= minBatches) && (halfWidth() <= precision*fabs(mean()));
+        }
+
+        private:
+
+        /* 97.5% quantile of Student's t, Cornish-Fisher expansion around the normal one */
+        static  double  tQuantile(unsigned int df)
+        {
+                    const double z = 1.959964;
+                    double z3 = z*z*z, z5 = z3*z*z;
+
+                    return z + (z3+z)/(4.0*df) + (5*z5 + 16*z3 + 3*z)/(96.0*df*df);
+        }
+
+        unsigned int        batchSize, minBatches, count;
+        double              sum;
+        std::vector<double> means;
+};
+
+#endif
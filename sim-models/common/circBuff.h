@@ -0,0 +1,193 @@
+#ifndef COMMON_CIRC_BUFF_H
+#define COMMON_CIRC_BUFF_H
+
+#include <new>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+/*
+    Ring buffer holding at most "limit" items of type "T".
+
+    Storage is rounded up to a power of two, head and tail run freely and are masked on access, so
+    size() is just their difference. Slots between head and tail may be left unconstructed: a presence
+    bitmap tells which ones hold an item, so the tail can jump ahead in O(1) and holes are filled
+    later (or never). Popping items that need no destructor only clears their bits.
+*/
+
+template<class T>
+class   circBuff
+{
+        public :
+
+        ~circBuff() { destroy(); }
+
+        circBuff(unsigned int _limit)
+        : limit(_limit), head(0), tail(0), array(nullptr)
+        {
+                    allocate(limit);
+        }
+
+        circBuff(const circBuff&) = delete;
+        circBuff& operator=(const circBuff&) = delete;
+
+        unsigned int    size()      const   { return (tail-head); }
+        unsigned int    capacity()  const   { return limit; }
+
+        bool        isFull()    const   { return (size() == limit); }
+        bool        isEmpty()   const   { return (head == tail); }
+
+        /* whether slot "index" (counted from the head) holds an item */
+        bool        has(unsigned int index) const
+        {
+                    unsigned int pos = (head+index) & mask;
+
+                    return (index < size()) && ((bits[pos >> 6] >> (pos & 63)) & 1);
+        }
+
+        T&          peek(unsigned int index)    { return operator[](index); }
+
+        T&          operator[](unsigned int index)
+        {
+                    assert(has(index));
+
+                    return array[(head+index) & mask];
+        }
+
+        /* constructs an item at slot "index", slots skipped on the way stay empty */
+        template<typename... Args>
+        T&          emplace(unsigned int index, Args&&... args)
+        {
+                    assert(index < limit);
+                    assert(!has(index));
+
+                    unsigned int pos = (head+index) & mask;
+
+                    new (&array[pos]) T(std::forward<Args>(args)...);
+                    bits[pos >> 6] |= (uint64_t(1) << (pos & 63));
+
+                    if(index >= size())
+                        tail = head+index+1;
+
+                    return array[pos];
+        }
+
+        template<typename... Args>
+        void        push(Args&&... args)
+        {
+                    assert(!isFull());
+
+                    emplace(size(), std::forward<Args>(args)...);
+        }
+
+        /* drops the first "n" slots (more than size() empties the buffer), returns how many held an item */
+        unsigned int    pop(unsigned int n)
+        {
+                    unsigned int count = 0;
+                    unsigned int valid = (n < size())? n : size();
+
+                    for(unsigned int i=0; i<valid; )
+                    {
+                        unsigned int pos = (head+i) & mask;
+                        unsigned int span = 64 - (pos & 63);
+
+                        /* stay within one word and do not wrap around the storage */
+                        if(span > (mask+1-pos))
+                            span = mask+1-pos;
+
+                        if(span > (valid-i))
+                            span = valid-i;
+
+                        uint64_t range = (span == 64)? ~uint64_t(0) : (((uint64_t(1) << span) - 1) << (pos & 63));
+                        uint64_t present = bits[pos >> 6] & range;
+
+                        if(!std::is_trivially_destructible<T>::value)
+                        {
+                            for(unsigned int j=0; j<span; j++)
+                            {
+                                if((present >> ((pos+j) & 63)) & 1)
+                                    array[pos+j].~T();
+                            }
+                        }
+
+                        count += __builtin_popcountll(present);
+                        bits[pos >> 6] &= ~range;
+                        i += span;
+                    }
+
+                    head += n;
+
+                    if((int)(tail-head) < 0)
+                        tail = head;
+
+                    return count;
+        }
+
+        /* raises the limit, items keep their slots relative to the head */
+        void        grow(unsigned int newLimit)
+        {
+                    if(newLimit <= limit)
+                        return;
+
+                    if(newLimit > (mask+1))
+                    {
+                        T* oldArray = array;
+                        std::vector<uint64_t> oldBits;
+                        unsigned int oldMask = mask;
+
+                        oldBits.swap(bits);
+                        allocate(newLimit);
+
+                        for(unsigned int i=0; i<size(); i++)
+                        {
+                            unsigned int oldPos = (head+i) & oldMask;
+
+                            if((oldBits[oldPos >> 6] >> (oldPos & 63)) & 1)
+                            {
+                                unsigned int pos = (head+i) & mask;
+
+                                new (&array[pos]) T(std::move(oldArray[oldPos]));
+                                oldArray[oldPos].~T();
+                                bits[pos >> 6] |= (uint64_t(1) << (pos & 63));
+                            }
+                        }
+
+                        ::operator delete(oldArray);
+                    }
+
+                    limit = newLimit;
+        }
+
+        private :
+
+        void        allocate(unsigned int _limit)
+        {
+                    unsigned int cap = 1;
+
+                    while(cap < _limit)
+                        cap <<= 1;
+
+                    mask = cap-1;
+                    bits.assign((cap+63)/64, 0);
+                    array = (T*) ::operator new(cap*sizeof(T));
+        }
+
+        void        destroy()
+        {
+                    // call destructor for all items
+                    pop(size());
+                    // deallocate storage
+                    ::operator delete(array);
+        }
+
+        unsigned int            limit;
+        unsigned int            mask;
+        unsigned int            head;
+        unsigned int            tail;
+        T*                      array;
+        std::vector<uint64_t>   bits;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef COMMON_CLOUD_HOSTS_H
+#define COMMON_CLOUD_HOSTS_H
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <omnetpp.h>
+#include <inet/common/ModuleAccess.h>
+#include <inet/networklayer/common/InterfaceEntry.h>
+#include <inet/networklayer/contract/IInterfaceTable.h>
+
+/*
+    Bookkeeping the cloud delayers of the models (IpJsonCloudDelayer, MulticastCloudDelayer) share:
+      - cloudHosts   : index of the host of the "h" vector behind each interface of the cloud, looked
+                       up once per interface
+      - findPacket() : packet of a given type in the encapsulation chain of a datagram
+      - linkQueue    : packets of a host pair that queue behind each other at a fixed datarate
+*/
+
+class   cloudHosts
+{
+        public:
+
+        cloudHosts() : cloud(nullptr), ift(nullptr) {}
+
+        void        init(omnetpp::cModule* delayer, inet::IInterfaceTable* _ift)
+        {
+                    cloud = inet::getContainingNode(delayer);
+                    ift = _ift;
+        }
+
+        /* "h[3]" -> 3, -1 if the interface leads to another cloud or to the placeholder of a module in another partition */
+        int         hostOf(int interfaceId)
+        {
+                    if(interfaceId < 0)
+                        throw omnetpp::cRuntimeError("Invalid interface id %d", interfaceId);
+
+                    if((unsigned int)interfaceId >= interface2host.size())
+                        interface2host.resize(interfaceId+1, -1);
+
+                    int& hostIdx = interface2host[interfaceId];
+
+                    if(hostIdx == -1)
+                    {
+                        inet::InterfaceEntry *ie = ift->getInterfaceById(interfaceId);
+
+                        if(!ie)
+                            throw omnetpp::cRuntimeError("Invalid interface id %d", interfaceId);
+
+                        omnetpp::cGate *forwardGate = cloud->gate(ie->getNodeOutputGateId());
+                        omnetpp::cModule *node = inet::findContainingNode(forwardGate->getPathEndGate()->getOwnerModule());
+
+                        hostIdx = (node && node->isVector() && !strcmp(node->getName(), "h"))? node->getIndex() : -2;
+                    }
+
+                    return (hostIdx >= 0)? hostIdx : -1;
+        }
+
+        private:
+
+        omnetpp::cModule*       cloud;
+        inet::IInterfaceTable*  ift;
+        std::vector<int>        interface2host;     /* -1 until looked up, -2 for anything but a host */
+};
+
+/* packet of type P a datagram carries, nullptr if it carries something else */
+template<class P>
+const P*    findPacket(const omnetpp::cMessage *msg)
+{
+            const omnetpp::cPacket *pkt = dynamic_cast<const omnetpp::cPacket*>(msg);
+
+            while(pkt && !dynamic_cast<const P*>(pkt))
+                pkt = pkt->getEncapsulatedPacket();
+
+            return static_cast<const P*>(pkt);
+}
+
+class   linkQueue
+{
+        public:
+
+        linkQueue() : numHosts(0), datarate(0.0) {}
+
+        /* "datarate" in bps, 0 for no serialization delay */
+        void        init(unsigned int _numHosts, double _datarate)
+        {
+                    numHosts = _numHosts;
+                    datarate = _datarate;
+                    lastSent.assign(numHosts*numHosts, SIMTIME_ZERO);
+        }
+
+        /* time a packet of "bits" that host "src" sends to "dst" at "now" waits until its last bit is out */
+        omnetpp::simtime_t  delay(unsigned int src, unsigned int dst, int64_t bits, omnetpp::simtime_t now)
+        {
+                    if((datarate <= 0.0) || (src >= numHosts) || (dst >= numHosts))
+                        return SIMTIME_ZERO;
+
+                    omnetpp::simtime_t& last = lastSent[(src*numHosts)+dst];
+                    omnetpp::simtime_t start = (last > now)? last : now;
+
+                    last = start + (bits / datarate);
+                    return last - now;
+        }
+
+        private:
+
+        unsigned int                    numHosts;
+        double                          datarate;
+        std::vector<omnetpp::simtime_t> lastSent;   /* end of the last transmission of each host pair */
+};
+
+#endif
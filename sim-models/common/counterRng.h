@@ -0,0 +1,68 @@
+#ifndef COMMON_COUNTER_RNG_H
+#define COMMON_COUNTER_RNG_H
+
+#include <cstdint>
+
+/*
+    Counter-based random numbers (Philox4x32-10, Salmon et al., SC'11).
+
+    Every number is a pure function of a key and a counter, so a stream can be addressed by what it
+    is used for, e.g. (seed, link) as key and (sequence number, channel) as counter. The same packet
+    then sees the same draws in every run that uses the same seed, no matter in which order or by
+    which module the streams are consumed. The last counter word numbers the blocks of a stream,
+    each block yields four numbers.
+*/
+
+class   counterRng
+{
+        public:
+
+        counterRng(uint32_t key0, uint32_t key1, uint32_t c0, uint32_t c1, uint32_t c2 = 0)
+        : key{key0, key1}, ctr{c0, c1, c2, 0}, pos(4)
+        {}
+
+        /* uniform in (0,1), 0 and 1 are never returned */
+        double          uniform01()
+        {
+                    if(pos == 4)
+                    {
+                        philox(ctr, key, block);
+                        ctr[3]++;
+                        pos = 0;
+                    }
+
+                    return (block[pos++] + 0.5) * (1.0/4294967296.0);
+        }
+
+        static  void    philox(const uint32_t in[4], const uint32_t k[2], uint32_t out[4])
+        {
+                    uint32_t x0 = in[0], x1 = in[1], x2 = in[2], x3 = in[3];
+                    uint32_t k0 = k[0], k1 = k[1];
+
+                    for(int round=0; round<10; round++)
+                    {
+                        uint64_t p0 = (uint64_t)0xD2511F53 * x0;
+                        uint64_t p1 = (uint64_t)0xCD9E8D57 * x2;
+
+                        uint32_t y0 = (uint32_t)(p1 >> 32) ^ x1 ^ k0;
+                        uint32_t y1 = (uint32_t)p1;
+                        uint32_t y2 = (uint32_t)(p0 >> 32) ^ x3 ^ k1;
+                        uint32_t y3 = (uint32_t)p0;
+
+                        x0 = y0; x1 = y1; x2 = y2; x3 = y3;
+                        k0 += 0x9E3779B9;
+                        k1 += 0xBB67AE85;
+                    }
+
+                    out[0] = x0; out[1] = x1; out[2] = x2; out[3] = x3;
+        }
+
+        private:
+
+        uint32_t        key[2];
+        uint32_t        ctr[4];
+        uint32_t        block[4];
+        unsigned int    pos;
+};
+
+#endif
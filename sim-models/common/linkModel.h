@@ -0,0 +1,212 @@
+#ifndef COMMON_LINK_MODEL_H
+#define COMMON_LINK_MODEL_H
+
+#include <map>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdlib>
+#include <iostream>
+#include <jsoncpp/json/json.h>
+
+/*
+    Delay and loss of every host pair, read from a network description (e.g. networks/gamma100.ip.json).
+
+    Links are kept in a dense N x N array indexed by host number ("h3" -> 3), so looking one up is
+    constant time. Distributions follow the SciPy convention used by the scheduler: "loc" shifts
+    and "scale" stretches the standard distribution, "shape" is its shape parameter if it has one
+    and "u" is the average loss rate. Offsets and scales are given in ms and kept in seconds.
+
+    Sampling only needs a source of uniform numbers in (0,1), i.e. anything with uniform01(), so
+    the same model serves OMNeT++ RNGs as well as the ones of standalone tools.
+*/
+
+class   linkModel
+{
+        public:
+
+        enum    Distribution { NONE = 0, GAMMA, NORM, EXPON, UNIFORM, LOGNORM, WEIBULL, PARETO };
+
+        struct  link
+        {
+                Distribution    dist;               // NONE for pairs missing in the description
+                double          loc, scale, shape;  // in seconds, shape is unitless
+                double          u;                  // loss rate
+        };
+
+        static  const linkModel&    get(const std::string& path2net)
+        {
+                    static std::map<std::string,std::unique_ptr<linkModel>> registry;
+
+                    auto& entry = registry[path2net];
+
+                    if(!entry)
+                        entry.reset(new linkModel(path2net));
+
+                    return *entry;
+        }
+
+        unsigned int    hostCount() const   { return numHosts; }
+
+        const link&     getLink(unsigned int src, unsigned int dst) const
+        {
+                    static const link none = { NONE, 0.0, 0.0, 0.0, 0.0 };
+
+                    if((src >= numHosts) || (dst >= numHosts))
+                        return none;
+
+                    return links[(src*numHosts)+dst];
+        }
+
+        /* one-way delay in seconds */
+        template<class R>
+        static  double  sampleDelay(const link& l, R& rng)
+        {
+                    double x = 0.0;
+
+                    switch(l.dist)
+                    {
+                        case NONE:      return 0.0;
+                        case GAMMA:     { x = gamma(l.shape, rng); break; }
+                        case NORM:      { x = normal(rng); break; }
+                        case EXPON:     { x = -log(rng.uniform01()); break; }
+                        case UNIFORM:   { x = rng.uniform01(); break; }
+                        case LOGNORM:   { x = exp(l.shape * normal(rng)); break; }
+                        case WEIBULL:   { x = pow(-log(rng.uniform01()), 1.0/l.shape); break; }
+                        case PARETO:    { x = pow(rng.uniform01(), -1.0/l.shape); break; }
+                    }
+
+                    double delay = l.loc + (l.scale * x);
+
+                    return (delay > 0.0)? delay : 0.0;
+        }
+
+        template<class R>
+        static  bool    sampleLoss(const link& l, R& rng)
+        {
+                    return (l.u > 0.0) && (rng.uniform01() < l.u);
+        }
+
+        /* standard gamma with the given shape, Marsaglia-Tsang */
+        template<class R>
+        static  double  gamma(double shape, R& rng)
+        {
+                    if(shape < 1.0)
+                        return gamma(shape+1.0, rng) * pow(rng.uniform01(), 1.0/shape);
+
+                    double d = shape - (1.0/3.0);
+
+                    return gamma(d, 1.0/sqrt(9.0*d), rng);
+        }
+
+        /* same for shape >= 1, with d = shape-1/3 and c = 1/sqrt(9d) computed once per link */
+        template<class R>
+        static  double  gamma(double d, double c, R& rng)
+        {
+                    while(true)
+                    {
+                        double x, v;
+
+                        do
+                        {
+                            x = normal(rng);
+                            v = 1.0 + (c*x);
+                        }
+                        while(v <= 0.0);
+
+                        v = v*v*v;
+                        double u = rng.uniform01();
+
+                        if((u < 1.0 - (0.0331*x*x*x*x)) || (log(u) < (0.5*x*x) + (d*(1.0 - v + log(v)))))
+                            return d*v;
+                    }
+        }
+
+        /* standard normal, Box-Muller */
+        template<class R>
+        static  double  normal(R& rng)
+        {
+                    double u1 = rng.uniform01();
+                    double u2 = rng.uniform01();
+
+                    return sqrt(-2.0*log(u1)) * cos(2*M_PI*u2);
+        }
+
+        private:
+
+        linkModel(const std::string& path2net)
+        : numHosts(0)
+        {
+                    Json::Value obj;
+                    std::ifstream cfg(path2net.c_str(), std::ifstream::binary);
+
+                    if(!cfg.is_open())
+                    {
+                        std::cout << "Unable to open file " << path2net << std::endl;
+                        exit(3);
+                    }
+
+                    cfg >> obj;
+
+                    for(const auto& src:obj.getMemberNames())
+                    {
+                        if(hostIdx(src) >= numHosts)
+                            numHosts = hostIdx(src)+1;
+
+                        for(const auto& dst:obj[src].getMemberNames())
+                        {
+                            if(hostIdx(dst) >= numHosts)
+                                numHosts = hostIdx(dst)+1;
+                        }
+                    }
+
+                    links.assign(numHosts*numHosts, link{ NONE, 0.0, 0.0, 0.0, 0.0 });
+
+                    for(const auto& src:obj.getMemberNames())
+                    {
+                        for(const auto& dst:obj[src].getMemberNames())
+                        {
+                            const Json::Value& ndd = obj[src][dst];
+                            link& l = links[(hostIdx(src)*numHosts)+hostIdx(dst)];
+
+                            l.dist = distribution(ndd["dist"].asString());
+                            l.loc = ndd["loc"].asDouble() / 1000.0;
+                            l.scale = ndd["scale"].asDouble() / 1000.0;
+                            l.shape = ndd.get("shape", 0.0).asDouble();
+                            l.u = ndd.get("u", 0.0).asDouble();
+
+                            if((l.dist == GAMMA || l.dist == LOGNORM || l.dist == WEIBULL || l.dist == PARETO) && (l.shape <= 0.0))
+                            {
+                                std::cout << "link " << src << "->" << dst << " needs a positive shape" << std::endl;
+                                exit(1);
+                            }
+                        }
+                    }
+        }
+
+        static  unsigned int    hostIdx(const std::string& host)
+        {
+                    return std::stoi(host.substr(1));
+        }
+
+        static  Distribution    distribution(const std::string& name)
+        {
+                    if( name == "gamma" )       { return GAMMA; }
+                    if( name == "norm" )        { return NORM; }
+                    if( name == "expon" )       { return EXPON; }
+                    if( name == "uniform" )     { return UNIFORM; }
+                    if( name == "lognorm" )     { return LOGNORM; }
+                    if( name == "weibull_min" ) { return WEIBULL; }
+                    if( name == "pareto" )      { return PARETO; }
+
+                    std::cout << "unsupported delay distribution " << name << std::endl;
+                    exit(1);
+        }
+
+        unsigned int        numHosts;
+        std::vector<link>   links;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef COMMON_LINK_STREAMS_H
+#define COMMON_LINK_STREAMS_H
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "linkModel.h"
+#include "counterRng.h"
+
+/*
+    Delay and loss of each packet as a function of (link, stream, sequence number), for comparing
+    schedules with common random numbers.
+
+    The draws of a packet come from a counterRng keyed by the seed and the link, with the sequence
+    number and the stream (e.g. the channel) as counter, so token k of a channel sees the same delay
+    and loss in the baseline and in the optimized run as long as it crosses the same link. Draws are
+    made for "batchSize" consecutive sequence numbers of a stream at once, which keeps the constants
+    of the distribution in registers and matches the order in which producers send.
+*/
+
+class   linkStreams
+{
+        public:
+
+        struct  draw
+        {
+                double          delay;              // in seconds, 0 if lost
+                bool            lost;
+        };
+
+        linkStreams(const linkModel& _model, uint32_t _seed, unsigned int _batchSize = 64)
+        : model(_model), seed(_seed), batchSize(_batchSize)
+        {}
+
+        const draw&     sample(unsigned int src, unsigned int dst, unsigned int stream, unsigned int seqN)
+        {
+                    unsigned int linkIdx = (src*model.hostCount())+dst;
+                    batch& b = batches[((uint64_t)linkIdx << 32) | stream];
+                    unsigned int base = seqN - (seqN%batchSize);
+
+                    if(b.draws.empty() || (b.base != base))
+                        fill(b, model.getLink(src, dst), linkIdx, stream, base);
+
+                    return b.draws[seqN-base];
+        }
+
+        private:
+
+        struct  batch
+        {
+                unsigned int        base;
+                std::vector<draw>   draws;
+        };
+
+        void    fill(batch& b, const linkModel::link& l, unsigned int linkIdx, unsigned int stream, unsigned int base)
+        {
+                    b.base = base;
+                    b.draws.resize(batchSize);
+
+                    /* Marsaglia-Tsang constants of the link, shapes below 1 are boosted by one */
+                    bool gamma = (l.dist == linkModel::GAMMA);
+                    bool boost = gamma && (l.shape < 1.0);
+                    double d = (boost? l.shape+1.0 : l.shape) - (1.0/3.0);
+                    double c = gamma? 1.0/sqrt(9.0*d) : 0.0;
+
+                    for(unsigned int i=0; i<batchSize; i++)
+                    {
+                        counterRng rng(seed, linkIdx, base+i, stream);
+                        draw& dr = b.draws[i];
+
+                        dr.lost = linkModel::sampleLoss(l, rng);
+                        dr.delay = 0.0;
+
+                        if(dr.lost)
+                            continue;
+
+                        if(gamma)
+                        {
+                            double x = linkModel::gamma(d, c, rng);
+
+                            if(boost)
+                                x *= pow(rng.uniform01(), 1.0/l.shape);
+
+                            double delay = l.loc + (l.scale * x);
+                            dr.delay = (delay > 0.0)? delay : 0.0;
+                        }
+                        else
+                        {
+                            dr.delay = linkModel::sampleDelay(l, rng);
+                        }
+                    }
+        }
+
+        const linkModel&    model;
+        uint32_t            seed;
+        unsigned int        batchSize;
+        std::unordered_map<uint64_t,batch>  batches;    /* current batch of each (link, stream) */
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef COMMON_TOKEN_H
+#define COMMON_TOKEN_H
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+
+/*
+    Token of a channel buffer carrying a payload of type "T".
+
+    Sequence number and state are packed in one word: the lower 30 bits hold the sequence number,
+    the upper two bits tell whether data was received and whether it was read already.
+*/
+
+template<class T>
+class   token
+{
+        public:
+
+        bool            isEmpty()   const   { return !(word & INITIALIZED); }
+        unsigned int    getSeqN()   const   { return (word & SEQN_MASK); }
+
+        const T&        getData()
+        {
+                        assert(!isEmpty());
+
+                        word |= READ;
+
+                        return data;
+        }
+
+        void            copy(const T& _data)
+        {
+                        assert(isEmpty());
+
+                        if(!(word & READ))
+                        {
+                            data = _data;
+
+                            word |= INITIALIZED;
+                        }
+                        #ifdef ALREADY
+                        else
+                        {
+                            std::cout << "ignoring update to already consumed token" << std::endl;
+                        }
+                        #endif
+        }
+
+        token(unsigned int _seqN, const T& _data)
+        : word((_seqN & SEQN_MASK) | INITIALIZED), data(_data)
+        {}
+
+        token(unsigned int _seqN)
+        : word(_seqN & SEQN_MASK), data()
+        {}
+
+        private:
+
+        enum : uint32_t { SEQN_MASK = 0x3FFFFFFFu, INITIALIZED = (1u << 30), READ = (1u << 31) };
+
+        uint32_t        word;
+        T               data;
+};
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef COMMON_UDP_BUFFER_H
+#define COMMON_UDP_BUFFER_H
+
+#include <set>
+#include <algorithm>
+#include <string>
+#include <iostream>
+#include "circBuff.h"
+#include "token.h"
+
+//#define DEBUG_TOKEN_DROP
+
+/*
+    Reorder buffer of one channel, i.e. a window of "mem" sequence numbers starting at "minSeqN".
+
+    Tokens are stored in the slot of their sequence number as they arrive. Slots of tokens that have
+    not arrived are left empty and only turned into empty tokens once the consumer reads them, so a
+    token far ahead of the others is placed in O(1). A token beyond the window is handled according
+    to the overflow policy:
+      - DROP_NEWEST : the arriving token is dropped
+      - DROP_OLDEST : the window slides forward, tokens falling out of it are dropped and read as
+                      empty by the consumer
+      - GROW        : the window is doubled (or enlarged to fit the token)
+
+    Packets are passed in already cast by the caller, anything with getSequenceNumber() and
+    getPayload() will do, so the buffer itself does not depend on OMNeT++.
+
+    Tokens the consumer reads as empty are either overflowed (they arrived but were dropped or
+    evicted, or slid out of the window before they arrived) or lost, i.e. they had not arrived when
+    they were consumed. Both are counted when the token is consumed, lost ones that arrive after
+    that are counted as late as well.
+*/
+
+template<class T>
+class   udpBuffer
+{
+        public:
+
+        enum        OverflowPolicy { DROP_NEWEST = 0, DROP_OLDEST, GROW };
+
+        struct      counters
+        {
+                    unsigned long   dropped;        // tokens dropped on arrival (DROP_NEWEST)
+                    unsigned long   evicted;        // received tokens pushed out of the window (DROP_OLDEST)
+                    unsigned long   grown;          // number of times the window was enlarged (GROW)
+                    unsigned long   late;           // tokens that arrived after their slot was consumed
+                    unsigned long   lost;           // tokens consumed before they arrived
+                    unsigned int    highWater;      // most slots any arriving token needed, dropped ones included
+                    unsigned int    maxReorder;     // farthest a token arrived behind the newest one
+        };
+
+        /* maps the name used in .ini files to a policy, returns false if the name is unknown */
+        static  bool    parsePolicy(const std::string& name, OverflowPolicy& policy)
+        {
+                    if( name == "dropNewest" )      { policy = DROP_NEWEST; }
+                    else if( name == "dropOldest" ) { policy = DROP_OLDEST; }
+                    else if( name == "grow" )       { policy = GROW; }
+                    else                            { return false; }
+
+                    return true;
+        }
+
+        udpBuffer(unsigned int mem, OverflowPolicy _policy = DROP_NEWEST)
+        : policy(_policy), readSeqN(0), minSeqN(0), maxSeqN(0), stats{0,0,0,0,0,0,0}, evictedToken(0), buffer(mem)
+        {}
+
+        /* token "index" positions after the next one to be consumed */
+        token<T>&   readToken(unsigned int index = 0)
+        {
+                    unsigned int seqNum = readSeqN+index;
+
+                    /* token was pushed out of the window before it was consumed */
+                    if( (seqNum < minSeqN) || (seqNum-minSeqN >= buffer.capacity()) )
+                    {
+                        evictedToken = token<T>(seqNum);
+                        return evictedToken;
+                    }
+
+                    unsigned int idx = seqNum-minSeqN;
+
+                    if(!buffer.has(idx))
+                        buffer.emplace(idx, seqNum);
+
+                    return buffer[idx];
+        }
+
+        void        popToken(unsigned int count = 1)
+        {
+                    for(unsigned int seqNum=readSeqN; seqNum<readSeqN+count; seqNum++)
+                    {
+                        if(!hasArrived(seqNum) && (overflowed.erase(seqNum) == 0))
+                            stats.lost++;
+                    }
+
+                    readSeqN += count;
+
+                    if( readSeqN > minSeqN )
+                    {
+                        buffer.pop(readSeqN-minSeqN);
+                        minSeqN = readSeqN;
+                    }
+
+                    if( maxSeqN < minSeqN )
+                        maxSeqN = minSeqN;
+        }
+
+        /* nothing to reserve, tokens that did not arrive are turned into empty ones by readToken() */
+        void        waitForToken(unsigned int count = 1)
+        {}
+
+        /* returns whether the token was stored, i.e. it will be read by the consumer unless evicted later */
+        template<class P>
+        bool        addToken(const P* msg)
+        {
+                    return placeToken(msg->getSequenceNumber(), msg->getPayload());
+        }
+
+        const counters&     getCounters()   const   { return stats; }
+        unsigned int        capacity()      const   { return buffer.capacity(); }
+
+        /* oldest sequence number the window holds, tokens below it read as empty */
+        unsigned int        windowStart()   const   { return minSeqN; }
+
+        /* slots between the oldest unconsumed and the newest received token */
+        unsigned int        occupancy()     const   { return (maxSeqN-minSeqN); }
+
+        private:
+
+        /* whether token "seqNum" is in the window and holds data */
+        bool        hasArrived(unsigned int seqNum)
+        {
+                    unsigned int idx = seqNum-minSeqN;
+
+                    return (seqNum >= minSeqN) && buffer.has(idx) && !buffer[idx].isEmpty();
+        }
+
+        bool        placeToken(unsigned int seqNum, const T& data)
+        {
+                    if( seqNum < minSeqN )
+                    {
+                        /* window slid past it before it was consumed (DROP_OLDEST), read as empty but not lost */
+                        if( seqNum >= readSeqN )
+                            overflowed.insert(seqNum);
+
+                        stats.late++;
+                        #if defined(DEBUG_TOKEN) || defined(DEBUG_TOKEN_DROP)
+                        std::cout << "Token with seqN=" << seqNum << " arrived too late (minSeqN=" << minSeqN << ")" << std::endl;
+                        #endif
+                        return false;
+                    }
+
+                    if( seqNum-minSeqN+1 > stats.highWater )
+                        stats.highWater = seqNum-minSeqN+1;
+
+                    if( (seqNum+1 < maxSeqN) && (maxSeqN-1-seqNum > stats.maxReorder) )
+                        stats.maxReorder = maxSeqN-1-seqNum;
+
+                    if( (seqNum-minSeqN >= buffer.capacity()) && !makeRoom(seqNum) )
+                        return false;
+
+                    unsigned int idx = seqNum-minSeqN;
+
+                    if(buffer.has(idx))
+                    {
+                        /* empty token was already handed to the consumer, "token" makes sure data was not received before */
+                        buffer[idx].copy(data);
+                        #if defined(DEBUG_TOKEN) || defined(DEBUG_TOKEN_UPDATE)
+                        std::cout << "Updated token with seqN=" << seqNum << std::endl;
+                        #endif
+                    }
+                    else
+                    {
+                        buffer.emplace(idx, seqNum, data);
+                        #if defined(DEBUG_TOKEN) || defined(DEBUG_TOKEN_PUSH)
+                        std::cout << "Pushed token with seqN=" << seqNum << std::endl;
+                        #endif
+                    }
+
+                    if( seqNum >= maxSeqN )
+                        maxSeqN = seqNum+1;
+
+                    return true;
+        }
+
+        /* token with "seqNum" does not fit into the window, returns whether it should be stored anyway */
+        bool        makeRoom(unsigned int seqNum)
+        {
+                    unsigned int idx = seqNum-minSeqN;
+
+                    switch(policy)
+                    {
+                        case DROP_OLDEST:
+                        {
+                            unsigned int shift = idx-buffer.capacity()+1;
+
+                            for(unsigned int i=minSeqN; i<minSeqN+std::min(shift, buffer.size()); i++)
+                            {
+                                if(hasArrived(i))
+                                    overflowed.insert(i);
+                            }
+
+                            stats.evicted += buffer.pop(shift);
+                            minSeqN += shift;
+                            #if defined(DEBUG_TOKEN) || defined(DEBUG_TOKEN_DROP)
+                            std::cout << "Buffer overflow, sliding window to minSeqN=" << minSeqN << std::endl;
+                            #endif
+                            return true;
+                        }
+
+                        case GROW:
+                        {
+                            unsigned int newLimit = 2*buffer.capacity();
+
+                            if(newLimit <= idx)
+                                newLimit = idx+1;
+
+                            buffer.grow(newLimit);
+                            stats.grown++;
+                            return true;
+                        }
+
+                        default:
+                        {
+                            stats.dropped++;
+                            overflowed.insert(seqNum);
+                            #if defined(DEBUG_TOKEN) || defined(DEBUG_TOKEN_DROP)
+                            std::cout << "Buffer overflow, dropping token with seqN=" << seqNum << " (maxSeqN=" << maxSeqN << ")" << std::endl;
+                            #endif
+                            return false;
+                        }
+                    }
+        }
+
+        OverflowPolicy      policy;
+        unsigned int        readSeqN, minSeqN, maxSeqN;
+        counters            stats;
+        token<T>            evictedToken;
+        circBuff<token<T>>  buffer;
+        std::set<unsigned int>  overflowed;     // not consumed yet, arrived but dropped or evicted
+};
+
+#endif
@@ -0,0 +1,173 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+/*
+    Monte Carlo evaluation of scheduled T-RADF graphs (see graphSim.h), replications of all graphs
+    are spread over a pool of threads. For every graph it prints the mean SNR (pSignal/pNoise) of
+    each output and the weight-averaged SNR of the outputs in dB.
+*/
+
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <cstdio>
+#include <unistd.h>
+#include "graphSim.h"
+
+static  void    usage(const char* prog)
+{
+        std::cout << "usage: " << prog << " [options] [scheduled TRADF graph]..." << std::endl;
+        std::cout << "  -n <file>   network description (default ../../networks/gamma100.ip.json)" << std::endl;
+        std::cout << "  -r <num>    replications per graph (default 10)" << std::endl;
+        std::cout << "  -i <num>    iterations per replication (default 1000)" << std::endl;
+        std::cout << "  -t <num>    threads (default: one per core)" << std::endl;
+        std::cout << "  -s <num>    seed of the first replication (default 0)" << std::endl;
+        std::cout << "  -p <name>   replacement policy: static, lastSeen, runningAverage, ewma, linear or kalman" << std::endl;
+        std::cout << "  -o <name>   overflow policy: dropNewest, dropOldest or grow" << std::endl;
+        std::cout << "  -d <val>    value of empty tokens (static)" << std::endl;
+        std::cout << "  -a <val>    weight of the newest value (ewma)" << std::endl;
+        std::cout << "  -q <val>    process noise (kalman)" << std::endl;
+        std::cout << "  -m <val>    measurement noise (kalman)" << std::endl;
+        exit(1);
+}
+
+int     main(int argc, char** argv)
+{
+        std::string path2net = "../../networks/gamma100.ip.json";
+        std::string overflow = "dropNewest";
+        unsigned int numRep = 10, numThreads = std::thread::hardware_concurrency();
+        uint32_t seed = 0;
+        simParams params;
+        int opt;
+
+        /* defaults of LinearActor.ned */
+        params.numIter = 1000;
+        params.policy = "static";
+        params.predictor = predictorParams{ 0.0, 0.5, 1.0, 1.0 };
+        params.sine = sinusoid{ 10, 2.0, 5.0 };
+
+        while((opt = getopt(argc, argv, "n:r:i:t:s:p:o:d:a:q:m:h")) != -1)
+        {
+            switch(opt)
+            {
+                case 'n':   { path2net = optarg; break; }
+                case 'r':   { numRep = atoi(optarg); break; }
+                case 'i':   { params.numIter = atoi(optarg); break; }
+                case 't':   { numThreads = atoi(optarg); break; }
+                case 's':   { seed = strtoul(optarg, nullptr, 10); break; }
+                case 'p':   { params.policy = optarg; break; }
+                case 'o':   { overflow = optarg; break; }
+                case 'd':   { params.predictor.defaultVal = atof(optarg); break; }
+                case 'a':   { params.predictor.alpha = atof(optarg); break; }
+                case 'q':   { params.predictor.q = atof(optarg); break; }
+                case 'm':   { params.predictor.r = atof(optarg); break; }
+                default:    { usage(argv[0]); }
+            }
+        }
+
+        if((optind == argc) || (numRep == 0) || (params.numIter == 0))
+            usage(argv[0]);
+
+        if(numThreads == 0)
+            numThreads = 1;
+
+        if(!udpBuffer<double>::parsePolicy(overflow, params.overflowPolicy))
+        {
+            std::cout << "unknown overflow policy " << overflow << std::endl;
+            exit(1);
+        }
+
+        std::unique_ptr<replacementPolicy> probe(replacementPolicy::create(params.policy, 1, params.predictor));
+
+        if(!probe)
+        {
+            std::cout << "unknown replacement policy " << params.policy << std::endl;
+            exit(1);
+        }
+
+        /* shared, read-only state is built before any thread starts */
+        const linkModel& links = linkModel::get(path2net);
+        std::vector<const tradfGraph*> graphs;
+        std::vector<const refSignal*> references;
+
+        for(int i=optind; i<argc; i++)
+        {
+            graphs.push_back(&tradfGraph::get(argv[i]));
+            references.push_back(&refSignal::get(*graphs.back(), params.sine, params.numIter));
+        }
+
+        /* results[g][r] holds the SNR of each output of graph "g" in replication "r" */
+        std::vector<std::vector<std::vector<double>>> results(graphs.size(), std::vector<std::vector<double>>(numRep));
+        std::atomic<unsigned int> nextJob(0);
+        unsigned int numJobs = graphs.size()*numRep;
+        std::vector<std::thread> pool;
+
+        for(unsigned int t=0; t<numThreads; t++)
+        {
+            pool.emplace_back([&]()
+            {
+                for(unsigned int job=nextJob++; job<numJobs; job=nextJob++)
+                {
+                    unsigned int g = job/numRep, r = job%numRep;
+                    graphSim sim(*graphs[g], links, *references[g], params, seed+r);
+
+                    results[g][r] = sim.run();
+                }
+            });
+        }
+
+        for(auto& thread:pool)
+            thread.join();
+
+        for(unsigned int g=0; g<graphs.size(); g++)
+        {
+            const tradfGraph& graph = *graphs[g];
+            double weightedSNR = 0.0, totalWeight = 0.0;
+            unsigned int out = 0;
+
+            for(unsigned int id=0; id<graph.actorCount(); id++)
+            {
+                int outCh = graph.outputChannel(id);
+
+                if(outCh < 0)
+                    continue;
+
+                double sum = 0.0, sqSum = 0.0;
+
+                for(unsigned int r=0; r<numRep; r++)
+                {
+                    sum += results[g][r][out];
+                    sqSum += results[g][r][out]*results[g][r][out];
+                }
+
+                double mean = sum/numRep;
+                double stdDev = (numRep > 1)? sqrt(std::max(0.0, (sqSum - (numRep*mean*mean))/(numRep-1))) : 0.0;
+                double weight = graph.getChannel(outCh).weight;
+
+                std::cout << "output," << argv[optind+g] << "," << graph.getActor(id).name << ",SNR," << mean << ",stddev," << stdDev << ",weight," << weight << std::endl;
+
+                weightedSNR += weight*mean;
+                totalWeight += weight;
+                out++;
+            }
+
+            if(totalWeight > 0.0)
+                std::cout << "graph," << argv[optind+g] << ",SNR(dB)," << 10*log10(weightedSNR/totalWeight) << std::endl;
+            else
+                std::cout << "graph," << argv[optind+g] << ",no weighted outputs" << std::endl;
+        }
+
+        return 0;
+}
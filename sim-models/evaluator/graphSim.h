@@ -0,0 +1,239 @@
+#ifndef EVALUATOR_GRAPH_SIM_H
+#define EVALUATOR_GRAPH_SIM_H
+
+#include <queue>
+#include <memory>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include "../common/udpBuffer.h"
+#include "../common/linkStreams.h"
+#include "../random-graphs/src/include/refSignal.h"
+#include "../random-graphs/src/include/predictors.h"
+#include "../random-graphs/src/include/tradfGraph.h"
+
+/*
+    One replication of a scheduled T-RADF graph, without OMNeT++.
+
+    Actors behave like LinearActor with the direct transport: actor "a" reads its buffers at
+    ts + k*period, sends at ts + k*period + wcet and its tokens arrive after the delay of the link
+    between both hosts, or never if they are lost. Buffers and replacement policies are the ones of
+    LinearActor, and delay and loss are drawn from linkStreams, so replication "r" with seed "s" sees
+    the draws of a LinearActor run with commonRandomNumbers and crnSeed = s+r.
+
+    Events at the same time are handled in the order they were scheduled, as in OMNeT++.
+*/
+
+struct  simParams
+{
+        unsigned int                numIter;
+        std::string                 policy;
+        udpBuffer<double>::OverflowPolicy   overflowPolicy;
+        predictorParams             predictor;
+        sinusoid                    sine;
+};
+
+class   graphSim
+{
+        public:
+
+        /* told about every token that arrives and every token an actor reads from a buffer, e.g. by tests */
+        struct  observer
+        {
+                virtual void    arrived(double now, unsigned int ch, unsigned int seqN) {}
+                virtual void    consumed(double now, unsigned int ch, unsigned int seqN, unsigned int iter) {}
+        };
+
+        graphSim(const tradfGraph& _graph, const linkModel& links, const refSignal& _reference, const simParams& _params, uint32_t seed)
+        : graph(_graph), reference(_reference), params(_params), streams(links, seed), scheduled(0), watcher(nullptr),
+          pSignal(_graph.actorCount(), 0.0), pNoise(_graph.actorCount(), 0.0)
+        {
+                    for(unsigned int id=0; id<graph.actorCount(); id++)
+                    {
+                        auto prod = graph.producers(id);
+                        actorState state;
+
+                        for(unsigned int ch:prod)
+                        {
+                            state.buffers.emplace_back(new udpBuffer<double>(graph.getChannel(ch).mem, params.overflowPolicy));
+                            state.initialToken.push_back(graph.getChannel(ch).hasInitialToken);
+                        }
+
+                        state.policy.reset(replacementPolicy::create(params.policy, prod.size(), params.predictor));
+                        state.outVal = 0.0;
+                        actors.push_back(std::move(state));
+                    }
+        }
+
+        void        setObserver(observer* o)    { watcher = o; }
+
+        /* SNR of each output actor, in the order of actor ids */
+        std::vector<double>     run()
+        {
+                    for(unsigned int id=0; id<graph.actorCount(); id++)
+                        schedule(graph.getActor(id).ts, READ, id, 0, 0.0);
+
+                    while(!events.empty())
+                    {
+                        event e = events.top();
+                        events.pop();
+
+                        switch(e.kind)
+                        {
+                            case READ:      { read(e.time, e.a, e.b); break; }
+                            case SEND:      { send(e.time, e.a, e.b); break; }
+                            case ARRIVE:    { arrive(e.time, e.a, e.b, e.val); break; }
+                        }
+                    }
+
+                    std::vector<double> snr;
+
+                    /* an output that always matched its reference has no noise, its SNR is infinite */
+                    for(unsigned int id=0; id<graph.actorCount(); id++)
+                        if(graph.outputChannel(id) >= 0)
+                            snr.push_back((pNoise[id] > 0.0)? pSignal[id]/pNoise[id] : std::numeric_limits<double>::infinity());
+
+                    return snr;
+        }
+
+        private:
+
+        enum    EventKind { READ = 0, SEND, ARRIVE };
+
+        struct  event
+        {
+                double          time;
+                uint64_t        order;
+                EventKind       kind;
+                unsigned int    a, b;       // actor and iteration, or channel and sequence number
+                double          val;
+
+                bool            operator<(const event& e) const
+                {
+                                return (time != e.time)? (time > e.time) : (order > e.order);
+                }
+        };
+
+        /* what udpBuffer::addToken() needs of a packet */
+        struct  tokenMsg
+        {
+                unsigned int    seqN;
+                double          val;
+
+                unsigned int    getSequenceNumber() const   { return seqN; }
+                double          getPayload()        const   { return val; }
+        };
+
+        struct  actorState
+        {
+                std::vector<std::unique_ptr<udpBuffer<double>>> buffers;
+                std::vector<bool>                               initialToken;
+                std::unique_ptr<replacementPolicy>              policy;
+                double                                          outVal;
+        };
+
+        void        schedule(double time, EventKind kind, unsigned int a, unsigned int b, double val)
+        {
+                    events.push(event{ time, scheduled++, kind, a, b, val });
+        }
+
+        /* LinearActor::setOutVal() */
+        void        read(double now, unsigned int id, unsigned int iter)
+        {
+                    actorState& state = actors[id];
+                    double outVal = 0.0;
+
+                    for(unsigned int ch:graph.inputs(id))
+                        outVal += graph.getChannel(ch).weight * params.sine.sample(graph.getChannel(ch).input, iter);
+
+                    unsigned int i = 0;
+
+                    for(unsigned int ch:graph.producers(id))
+                    {
+                        double val = 0.0;
+
+                        if(state.initialToken[i])
+                        {
+                            state.policy->observe(i, val);
+                            state.initialToken[i] = false;
+                        }
+                        else
+                        {
+                            auto& tkn = state.buffers[i]->readToken();
+
+                            if(tkn.isEmpty())
+                            {
+                                val = state.policy->predict(i);
+                            }
+                            else
+                            {
+                                val = tkn.getData();
+                                state.policy->observe(i, val);
+
+                                if(watcher)
+                                    watcher->consumed(now, ch, tkn.getSeqN(), iter);
+                            }
+
+                            state.buffers[i]->popToken();
+                        }
+
+                        outVal += graph.getChannel(ch).weight * val;
+                        i++;
+                    }
+
+                    state.outVal = outVal;
+                    schedule(now + graph.getActor(id).wcet, SEND, id, iter, 0.0);
+        }
+
+        /* LinearActor::sendVal() */
+        void        send(double now, unsigned int id, unsigned int iter)
+        {
+                    const tradfGraph::actor& actor = graph.getActor(id);
+                    double outVal = actors[id].outVal;
+
+                    if(graph.outputChannel(id) >= 0)
+                    {
+                        double refVal = reference.value(id, iter);
+
+                        pSignal[id] += refVal*refVal;
+                        pNoise[id] += (refVal-outVal)*(refVal-outVal);
+                    }
+                    else
+                    {
+                        for(unsigned int ch:graph.consumers(id))
+                        {
+                            const tradfGraph::actor& target = graph.getActor(graph.getChannel(ch).target);
+                            const linkStreams::draw& d = streams.sample(actor.hostIdx, target.hostIdx, ch, iter);
+
+                            if(!d.lost)
+                                schedule(now + d.delay, ARRIVE, ch, iter, outVal);
+                        }
+                    }
+
+                    if(iter+1 < params.numIter)
+                        schedule(now + (graph.getPeriod() - actor.wcet), READ, id, iter+1, 0.0);
+        }
+
+        void        arrive(double now, unsigned int ch, unsigned int seqN, double val)
+        {
+                    const tradfGraph::channel& channel = graph.getChannel(ch);
+                    tokenMsg msg = { seqN, val };
+
+                    if(watcher)
+                        watcher->arrived(now, ch, seqN);
+
+                    actors[channel.target].buffers[channel.slot]->addToken(&msg);
+        }
+
+        const tradfGraph&           graph;
+        const refSignal&            reference;
+        const simParams&            params;
+        linkStreams                 streams;
+        uint64_t                    scheduled;
+        observer*                   watcher;
+        std::priority_queue<event>  events;
+        std::vector<actorState>     actors;
+        std::vector<double>         pSignal, pNoise;
+};
+
+#endif
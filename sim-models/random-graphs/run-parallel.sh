@@ -0,0 +1,8 @@
+#!/bin/bash
+# usage: ./run-parallel.sh [processes], the hosts are split between them by scripts/partition.py
+N=${1:-8}
+python ../../scripts/partition.py scheduled.tradf.json ../../networks/gamma100.ip.json $N partitions.ini || exit 1
+for ((p=0; p<N; p++)); do
+    ./SchedStream -m -u Cmdenv -c partitioned -p$p,$N -n .:../inet/src:../inet/examples:../inet/tutorials:../inet/showcases --image-path=../inet/images -l ../inet/src/INET partitions.ini &
+done
+wait
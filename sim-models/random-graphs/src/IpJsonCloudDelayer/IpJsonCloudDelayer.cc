@@ -0,0 +1,128 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+
+#include "IpJsonCloudDelayer.h"
+#include <inet/networklayer/contract/INetworkDatagram.h>
+#include <cstdio>
+
+Define_Module(IpJsonCloudDelayer);
+
+IpJsonCloudDelayer::IpJsonCloudDelayer()
+:       links(nullptr),
+        streams(nullptr)
+{
+        rng.rng = nullptr;
+}
+
+IpJsonCloudDelayer::~IpJsonCloudDelayer()
+{
+        delete streams;
+}
+
+void    IpJsonCloudDelayer::initialize(int stage)
+{
+        CloudDelayerBase::initialize(stage);
+
+        if(stage == inet::INITSTAGE_LOCAL)
+        {
+            links = &linkModel::get(par("linkModel").stdstringValue());
+            hosts.init(this, inet::getModuleFromPar<inet::IInterfaceTable>(par("interfaceTableModule"), this));
+            rng.rng = getRNG(0);
+            lookahead = par("lookahead").doubleValue();
+
+            /* <interface hosts='h[3]' address='...'/> entries of a configurator file */
+            for(cXMLElement *e:par("hostAddresses").xmlValue()->getChildrenByTagName("interface"))
+            {
+                const char *hostName = e->getAttribute("hosts");
+                const char *address = e->getAttribute("address");
+                unsigned int hostIdx;
+                char rest;
+
+                if(hostName && address && (sscanf(hostName, "h[%u]%c", &hostIdx, &rest) == 1))
+                    address2host[inet::L3Address(address)] = hostIdx;
+            }
+
+            if(par("commonRandomNumbers").boolValue())
+                streams = new linkStreams(*links, (uint)par("crnSeed").intValue());
+
+            queue.init(links->hostCount(), par("datarate").doubleValue());
+        }
+}
+
+/* index of the host a datagram is addressed to, -1 if hostAddresses does not know it */
+int     IpJsonCloudDelayer::hostByAddress(const cMessage *msg) const
+{
+        const inet::INetworkDatagram *datagram = dynamic_cast<const inet::INetworkDatagram*>(msg);
+
+        if(!datagram)
+            return -1;
+
+        auto it = address2host.find(datagram->getDestinationAddress());
+
+        return (it == address2host.end())? -1 : it->second;
+}
+
+void    IpJsonCloudDelayer::calculateDropAndDelay(const cMessage *msg, int srcID, int destID, bool& outDrop, simtime_t& outDelay)
+{
+        Enter_Method_Silent();
+
+        outDrop = false;
+        outDelay = SIMTIME_ZERO;
+
+        /* packets from another cloud got the delay of their path there already */
+        int srcHost = hosts.hostOf(srcID);
+
+        if(srcHost < 0)
+            return;
+
+        int dstHost = hosts.hostOf(destID);
+        bool viaCloud = (dstHost < 0);
+
+        if(viaCloud && ((dstHost = hostByAddress(msg)) < 0))
+            throw cRuntimeError("Packet %s leaves towards another cloud, but hostAddresses has no host with its destination address", msg->getName());
+
+        uint src = srcHost;
+        uint dst = dstHost;
+        const linkModel::link& l = links->getLink(src, dst);
+
+        /* tokens draw from their own stream, anything else (e.g. ARP) from the module's RNG */
+        const tokenPacket *tp = streams? findPacket<tokenPacket>(msg) : nullptr;
+
+        if(tp)
+        {
+            const linkStreams::draw& d = streams->sample(src, dst, tp->getChannel(), tp->getSequenceNumber());
+
+            outDrop = d.lost;
+            outDelay = d.delay;
+        }
+        else
+        {
+            outDrop = linkModel::sampleLoss(l, rng);
+
+            if(!outDrop)
+                outDelay = linkModel::sampleDelay(l, rng);
+        }
+
+        if(outDrop)
+            return;
+
+        /* packets of a host pair queue behind each other, like MatrixCloudDelayer does with "datarate" */
+        outDelay += queue.delay(src, dst, check_and_cast<const cPacket*>(msg)->getBitLength(), simTime());
+
+        /* the link to the other cloud adds the lookahead on the way */
+        if(viaCloud)
+            outDelay = (outDelay > lookahead)? outDelay - lookahead : SIMTIME_ZERO;
+}
@@ -0,0 +1,64 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef SCHEDSTREAM_IP_JSON_CLOUD_DELAYER_H
+#define SCHEDSTREAM_IP_JSON_CLOUD_DELAYER_H
+
+#include "../include/typedefs.h"
+#include "tokenPacket_m.h"
+#include "../../../common/cloudHosts.h"
+#include <inet/node/internetcloud/CloudDelayerBase.h>
+#include <inet/networklayer/contract/IInterfaceTable.h>
+#include <inet/networklayer/common/L3Address.h>
+
+/*
+    Delayer of the InternetCloud that takes delay and loss of each host pair from the network
+    description (.ip.json) instead of MatrixCloudDelayer's XML patterns. Interfaces of the cloud are
+    mapped to the index of the host they lead to once, after that every packet costs two vector
+    lookups and the samples of its link.
+
+    The network may hold one cloud per partition of a parallel run. A packet then gets the delay and
+    loss of its host pair in the cloud it enters from its source host. That cloud finds the
+    destination host by address (hostAddresses), and the packet passes the other cloud unchanged.
+    The links between clouds carry the lookahead, which is taken off the delay of the packets that
+    cross them, so a path is only longer than in a single cloud when its delay is below the lookahead.
+*/
+
+class   INET_API IpJsonCloudDelayer : public inet::CloudDelayerBase
+{
+        private:
+
+        int         hostByAddress(const cMessage *msg) const;
+
+        const linkModel*        links;
+        cloudHosts              hosts;
+        omnetRng                rng;
+        linkStreams*            streams;                /* common random numbers per link and token, nullptr if disabled */
+        simtime_t               lookahead;              /* delay of the links to other clouds */
+        std::map<inet::L3Address,int>   address2host;   /* host index by interface address, for hosts behind other clouds */
+        linkQueue               queue;                  /* datarate of each host pair */
+
+        protected:
+
+        virtual void    initialize(int stage) override;
+        virtual void    calculateDropAndDelay(const cMessage *msg, int srcID, int destID, bool& outDrop, simtime_t& outDelay) override;
+
+        public:
+
+        IpJsonCloudDelayer();
+        ~IpJsonCloudDelayer();
+};
+
+#endif /* SCHEDSTREAM_IP_JSON_CLOUD_DELAYER_H */
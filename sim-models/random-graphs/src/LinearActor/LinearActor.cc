@@ -19,7 +19,6 @@
 #include <cmath>
 #include <cctype>
 #include <fstream>
-#include <inet/applications/base/ApplicationPacket_m.h>
 
 Define_Module(LinearActor);
 
@@ -29,11 +28,28 @@ void    LinearActor::sendVal()
         {
             assert(!hasInput);
 
-            emulateSDFIteration();
+            double refVal = reference->value(actorId, iterCnt);
 
-            pSignal += pow(actorVals[name],2);
-            pNoise += pow((actorVals[name]-outVal),2);
+            pSignal += pow(refVal,2);
+            pNoise += pow((refVal-outVal),2);
 
+            emit(outputErrorSignal, refVal-outVal);
+
+            /* signal power is known, so the noise power decides how precise the SNR is */
+            if(noiseCI && !converged)
+            {
+                noiseCI->observe(pow((refVal-outVal),2));
+
+                if(noiseCI->converged(targetPrecision))
+                {
+                    converged = true;
+
+                    if(!quiet) { std::cout << "output " << name << " converged after " << iterCnt+1 << " iterations" << std::endl; }
+
+                    if(outputsConverged())
+                        endSimulation();
+                }
+            }
         }
         else
         {
@@ -41,12 +57,38 @@ void    LinearActor::sendVal()
 
             for(uint i=0; i<consumers.size(); i++)
             {
-                inet::ApplicationPacket *msg = new inet::ApplicationPacket("token");
-                msg->setByteLength(sizeof(double)+sizeof(uint));
+                tokenPacket *msg = newToken();
+                msg->setByteLength(sizeof(double)+(2*sizeof(uint)));
                 msg->setSequenceNumber(iterCnt);
-                msg->addPar("data") = outVal;
+                msg->setChannel(consumers[i]->channel);
+                msg->setPayload(outVal);
+                msg->setTimestamp();
 
-                outSockets[i]->sendTo(msg, consumers[i]->addr, consumers[i]->port);
+                if(direct)
+                {
+                    /* delay and loss of the link between both hosts, as the cloud would apply them */
+                    if(streams)
+                    {
+                        const linkStreams::draw& d = streams->sample(graph->getActor(actorId).hostIdx, consumerHosts[i], consumers[i]->channel, iterCnt);
+
+                        if(d.lost)
+                            recycleToken(msg);
+                        else
+                            sendDirect(msg, d.delay, 0, consumerGates[i]);
+                    }
+                    else if(linkModel::sampleLoss(*consumerLinks[i], rng))
+                    {
+                        recycleToken(msg);
+                    }
+                    else
+                    {
+                        sendDirect(msg, linkModel::sampleDelay(*consumerLinks[i], rng), 0, consumerGates[i]);
+                    }
+                }
+                else
+                {
+                    socket->sendTo(msg, consumers[i]->addr, consumers[i]->port);
+                }
             }
         }
 
@@ -57,14 +99,26 @@ void    LinearActor::sendVal()
             selfMsg->setKind(POP);
             scheduleAt(simTime()+(period-wcet), selfMsg);
         }
-        else
+}
+
+/* whether every output actor of the graph reached the target precision */
+bool    LinearActor::outputsConverged()
+{
+        cModule* network = getSimulation()->getSystemModule();
+
+        for(uint id=0; id<graph->actorCount(); id++)
         {
-            //printLoss();
+            if(graph->outputChannel(id) < 0)
+                continue;
 
-            if(isOutput) { std::cout << "pSignal:" << pSignal << ",pNoise:" << pNoise << std::endl; }
+            cModule* outHost = network->getSubmodule("h", graph->getActor(id).hostIdx);
+            LinearActor* out = outHost? dynamic_cast<LinearActor*>(outHost->getSubmodule("udpApp", 0)) : nullptr;
 
-            if(isOutput) { std::cout << "output," << name << ",SNR," << pSignal/pNoise << ",weight," << snrWeight << std::endl; }
+            if(out && !out->converged)
+                return false;
         }
+
+        return true;
 }
 
 void    LinearActor::setOutVal()
@@ -78,11 +132,10 @@ void    LinearActor::setOutVal()
         {
             if(producers[i]->hasInitialToken)
             {
-                std::cout << "producer " << i << " of " << name << " has initial token" << std::endl;
+                if(!quiet) { std::cout << "producer " << i << " of " << name << " has initial token" << std::endl; }
 
                 val = 0; // FIXME: initialTokens are assumed to be zero
-                runningSums[i] += val;
-                lastSeenVals[i] = val;
+                myPolicy->observe(i, val);
 
                 producers[i]->hasInitialToken = false; // no more initial token
             }
@@ -92,49 +145,15 @@ void    LinearActor::setOutVal()
 
                 if(buffers[i]->readToken().isEmpty())
                 {
-                    switch(myPolicy)
-                    {
-                        case STATIC:
-                        {
-                            val = defaultVal; /* FIXME: need to know multiplicative weights as well */
-                            break;
-                        }
-
-                        case LAST:
-                        {
-                            val = lastSeenVals[i]; // FIXME: what if no value has been received so far?
-                            break;
-                        }
-
-                        case AVG:
-                        {
-                            uint numSamples = iterCnt-lostCount[i];
-
-                            if(numSamples==0)
-                            {
-                                val = 0.0; // FIXME
-                            }
-                            else
-                            {
-                                val = runningSums[i] / numSamples;
-                            }
-                            break;
-                        }
-
-                        default:
-                        {
-                            std::cout << "something bad happened!" << std::endl;
-                            exit(1);
-                        }
-                    }
-
+                    val = myPolicy->predict(i);
                     lostCount[i]++;
+
+                    emit(emptyTokenSignal, i);
                 }
                 else
                 {
                     val = buffers[i]->readToken().getData();
-                    runningSums[i] += val;
-                    lastSeenVals[i] = val;
+                    myPolicy->observe(i, val);
                 }
 
                 buffers[i]->popToken();
@@ -149,7 +168,7 @@ void    LinearActor::setOutVal()
         scheduleAt(simTime()+wcet, selfMsg);
 }
 
-double  LinearActor::genVal(arr<str2> inArr, arr<double> weightArr)
+double  LinearActor::genVal(arr<uint> inArr, arr<double> weightArr)
 {
         double val = 0;
 
@@ -159,54 +178,64 @@ double  LinearActor::genVal(arr<str2> inArr, arr<double> weightArr)
         return val;
 }
 
-double  LinearActor::sampleInput(str2 inputName)
+double  LinearActor::sampleInput(uint index)
 {
-        uint index = atoi(inputName.substr(1).c_str());
-
-        return sineBase + (sineAmplitude * sin((2*M_PI*(iterCnt+index))/sinePeriod));
+        return sine.sample(index, iterCnt);
 }
 
-void    LinearActor::printLoss()
+void    LinearActor::processPacket(cPacket *msg)
 {
-        std::cout << name << ": ";
+        auto ctrl = check_and_cast<inet::UDPDataIndication*>(msg->removeControlInfo());
 
-        for(uint i=0; i<lostCount.size(); i++)
-        {
-            std::cout << 1.0-((double)(lostCount[i])/iterCnt) << " ";
-        }
+        deliverToken(check_and_cast<tokenPacket*>(msg));
 
-        std::cout << std::endl;
+        delete ctrl;
 }
 
-void    LinearActor::processPacket(cPacket *msg)
+void    LinearActor::deliverToken(tokenPacket *pkt)
 {
-        bool valid = false;
-        auto ctrl  = check_and_cast<inet::UDPDataIndication*>(msg->removeControlInfo());
-        auto srcAddr = ctrl->getSrcAddr();
+        uint ch = pkt->getChannel();
 
-        for(uint i=0; i<producers.size(); i++)
+        if((ch < graph->channelCount()) && (graph->getChannel(ch).target == actorId))
         {
-            if(producers[i]->addr == srcAddr)
-            {
-                valid = true;
+            uint slot = graph->getChannel(ch).slot;
 
-                if(producers[i]->port != (uint)(ctrl->getDestPort()))
-                {
-                    std::cout << "expected data from port " << producers[i]->port << " but got " << ctrl->getDestPort() << std::endl;
-                    assert(false);
-                }
+            /* token is consumed when this actor fires for its iteration, one later on backedges */
+            simtime_t deadline = ts + (graph->consumingIteration(ch, pkt->getSequenceNumber()) * period);
 
-                buffers[i]->addToken(msg);
-                //std::cout << "actor " << name << " received data from " << producers[i].actor << std::endl;
-                break;
-            }
-        }
+            latency[slot]->collect(simTime() - pkt->getTimestamp());
+            slack[slot]->collect(simTime() - deadline);
 
-        if(!valid)
+            buffers[slot]->addToken(pkt);
+            occupancy[slot]->collect(buffers[slot]->occupancy());
+            //std::cout << "actor " << name << " received data from " << producers[slot]->actor << std::endl;
+        }
+        else
+        {
             std::cout << "actor " << name << " received data from unknown source" << std::endl;
+        }
 
-        delete msg;
-        delete ctrl;
+        recycleToken(pkt);
+}
+
+tokenPacket*    LinearActor::newToken()
+{
+        if(tokenPool.empty())
+            return new tokenPacket("token");
+
+        tokenPacket* msg = tokenPool.back();
+        tokenPool.pop_back();
+
+        return msg;
+}
+
+void    LinearActor::recycleToken(tokenPacket *msg)
+{
+        /* keep at most one iteration worth of tokens, tokens are owned by this module meanwhile */
+        if(tokenPool.size() < consumers.size())
+            tokenPool.push_back(msg);
+        else
+            delete msg;
 }
 
 void    LinearActor::handleMessageWhenUp(cMessage *msg)
@@ -234,6 +263,10 @@ void    LinearActor::handleMessageWhenUp(cMessage *msg)
                 }
             }
         }
+        else if( msg->arrivedOn("directIn") )
+        {
+            deliverToken(check_and_cast<tokenPacket*>(msg));
+        }
         else if( msg->getKind() == inet::UDP_I_DATA )
         {
             processPacket(PK(msg));
@@ -251,7 +284,8 @@ void    LinearActor::handleMessageWhenUp(cMessage *msg)
 
 bool    LinearActor::handleNodeStart(inet::IDoneCallback *doneCallback)
 {
-        printInfo();
+        if(!quiet)
+            printInfo();
 
         if(!idle)
         {
@@ -270,12 +304,9 @@ void    LinearActor::printInfo()
         std::cout << "actor:" << name << " (hasInput=" << hasInput << ", isOutput=" << isOutput << ", host=" << host << ", ts=" << ts << "s, wcet=" << wcet << "s";
         std::cout << ", producers: ";
         printActors(producers);
-        std::cout << ", srcPorts: ";
-        printPorts(producers);
         std::cout << ", consumers: ";
         printActors(consumers);
-        std::cout << ", dstPorts: ";
-        printPorts(consumers);
+        std::cout << ", port: " << graph->getActor(actorId).port;
         std::cout << ")" << std::endl;
 }
 
@@ -285,231 +316,259 @@ void    LinearActor::initialize(int stage)
 
         if(stage == inet::INITSTAGE_LOCAL)
         {
-            Json::Value obj;
+            sine.base = par("sineBase");
+            sine.amplitude = par("sineAmplitude");
+
+            /* samples and the folding of the reference signal are taken modulo the period */
+            int sinePeriod = par("sinePeriod");
+
+            if(sinePeriod <= 0)
+                throw cRuntimeError("sinePeriod must be a positive number of iterations, got %d", sinePeriod);
+
+            sine.period = sinePeriod;
 
-            sineBase = par("sineBase");
-            sinePeriod = par("sinePeriod");
-            sineAmplitude = par("sineAmplitude");
+            quiet = par("quiet");
+            outputErrorSignal = registerSignal("outputError");
+            emptyTokenSignal = registerSignal("emptyToken");
+            snrSignal = registerSignal("snr");
 
-            defaultVal = par("defaultVal");
             str2 rp = par("replacementPolicy");
             str2 aName = par("name");
             str2 path2graph = par("graph");
 
             name = aName;
 
-            if( rp == "static" )
-            {
-                myPolicy = STATIC;
-            }
-            else if( rp == "lastSeen" )
-            {
-                myPolicy = LAST;
-            }
-            else if( rp == "runningAverage" )
+            str2 tp = par("transport");
+
+            if( tp == "direct" )
             {
-                myPolicy = AVG;
+                direct = true;
             }
-            else
+            else if( tp != "udp" )
             {
-                std::cout << "unknown replacement policy " << rp << ", using static policy" << std::endl;
-                myPolicy = STATIC;
+                std::cout << "unknown transport " << tp << ", using udp" << std::endl;
             }
 
-            std::ifstream cfg(path2graph.c_str(), std::ifstream::binary);
+            str2 op = par("overflowPolicy");
 
-            if(!cfg.is_open())
+            if( !valBuffer::parsePolicy(op, overflowPolicy) )
             {
-                std::cout << "Unable to open file " << path2graph << std::endl;
-                exit(3);
+                std::cout << "unknown overflow policy " << op << ", dropping newest tokens" << std::endl;
+                overflowPolicy = valBuffer::DROP_NEWEST;
             }
 
-            cfg >> obj;
+            /* graph is parsed by the first actor, the rest share it */
+            graph = &tradfGraph::get(path2graph);
+            actorId = graph->actorId(name);
+            period = graph->getPeriod();
 
-            period = conv2sec(obj["period"].asString());
-            channels = obj["channels"];
-
-            parseActors(obj["actors"]);
-
-            Json::Value exeOrderArr = obj["executionOrder"];
-            for(uint i=0; i<exeOrderArr.size(); i++)
+            if(actorId >= 0)
             {
-                str2 actorName = exeOrderArr[i].asString();
-                exeOrder.push_back(actorName);
-                actorVals.insert(std::pair<str2,double>(actorName,0.0));
+                auto& actor = graph->getActor(actorId);
+
+                idle = false;
+                host = actor.host;
+                ts = actor.ts;
+                wcet = actor.wcet;
             }
 
             if(!idle)
             {
-                parseChannels(obj["channels"]);
+                parseChannels();
 
                 selfMsg = new cMessage("scheduler");
 
-                auto myAddr = netInfo::getIP(host);
+                if(direct)
+                {
+                    rng.rng = getRNG(0);
 
-                for(uint i=0; i<producers.size(); i++)
+                    if(links && par("commonRandomNumbers").boolValue())
+                        streams = new linkStreams(*links, (uint)par("crnSeed").intValue());
+                }
+                else
                 {
-                    auto sPtr = new sock();
-                    sPtr->setOutputGate(gate("udpOut"));
-                    sPtr->bind(myAddr, producers[i]->port);
-
-                    inSockets.push_back(sPtr);
-                    lostCount.push_back(0);
-                    runningSums.push_back(0);
-                    lastSeenVals.push_back(0);
+                    /* one socket per actor, tokens are dispatched to buffers by their channel */
+                    socket = new sock();
+                    socket->setOutputGate(gate("udpOut"));
+                    socket->bind(netInfo::getIP(host), graph->getActor(actorId).port);
                 }
 
-                for(uint i=0; i<consumers.size(); i++)
-                {
-                    auto sPtr = new sock();
-                    sPtr->setOutputGate(gate("udpOut"));
+                predictorParams params;
+                params.defaultVal = par("defaultVal");
+                params.alpha = par("ewmaAlpha");
+                params.q = par("kalmanQ");
+                params.r = par("kalmanR");
+
+                myPolicy = replacementPolicy::create(rp, producers.size(), params);
 
-                    outSockets.push_back(sPtr);
+                if(!myPolicy)
+                {
+                    std::cout << "unknown replacement policy " << rp << ", using static policy" << std::endl;
+                    myPolicy = replacementPolicy::create("static", producers.size(), params);
                 }
+
+                lostCount.assign(producers.size(), 0);
             }
 
             if(isOutput)
             {
-                std::cout << "execution order: ";
-                for(const auto& str2:exeOrder)
-                    std::cout << str2 << " ";
-                std::cout << std::endl;
-            }
-        }
-}
+                reference = &refSignal::get(*graph, sine, par("numIter"));
+                targetPrecision = par("targetPrecision");
 
-void    LinearActor::parseActors(Json::Value actorArr)
-{
-        for(const auto& actor:actorArr)
-        {
-            auto currName = actor["name"].asString();
-            auto currHost = actor["host"].asString();
+                /* outputsConverged() reads the other outputs directly, which only works in a single process */
+                if((targetPrecision > 0.0) && (getSimulation()->getParsimNumPartitions() > 1))
+                    throw cRuntimeError("targetPrecision needs a sequential run, set it to 0 with parallel-simulation");
 
-            actor2host[currName] = currHost;
-
-            if(currName == name)
-            {
-                assert(idle);
+                if(targetPrecision > 0.0)
+                    noiseCI = new batchMeans((uint)par("ciBatchSize"), (uint)par("ciMinBatches"));
 
-                idle = false;
-                host = currHost;
-                ts = conv2sec(actor["ts"].asString());
-                wcet = conv2sec(actor["wcet"].asString());
+                if(!quiet)
+                {
+                    std::cout << "execution order: ";
+                    for(uint id:graph->executionOrder())
+                        std::cout << graph->getActor(id).name << " ";
+                    std::cout << std::endl;
+                }
             }
         }
 }
 
-void    LinearActor::parseChannels(Json::Value chArr)
+void    LinearActor::parseChannels()
 {
-        for(uint i=0; i<chArr.size(); i++)
+        int outCh = graph->outputChannel(actorId);
+
+        if(outCh >= 0)
         {
-            uint port = 11000+i;
+            isOutput = true;
+            snrWeight = graph->getChannel(outCh).weight;
+        }
 
-            auto source = chArr[i]["source"].asString();
-            auto weight = chArr[i]["weight"].asDouble();
+        for(uint ch:graph->consumers(actorId))
+        {
+            auto& channel = graph->getChannel(ch);
+            auto& target = graph->getActor(channel.target);
 
-            if(source == name)
-            {
-                if(chArr[i]["target"] == Json::Value::null)
-                {
-                    isOutput = true;
-                    snrWeight = weight;
-                }
-                else
-                {
-                    auto target = chArr[i]["target"].asString();
-                    //std::cout << "consumer " << target << ":" << port << std::endl;
-                    consumers.push_back(new netInfo(target, actor2host[target], weight, port, false));
-                }
-            }
-            else if(chArr[i]["target"].asString() == name)
+            //std::cout << "consumer " << target.name << ":" << target.port << std::endl;
+            consumers.push_back(new netInfo(target.name, target.host, channel.weight, target.port, ch, false));
+
+            if(direct)
             {
-                if(source[0] == 'i')
+                /* consumer runs as udpApp[0] of host h<hostIdx> in the abstract network as well */
+                cModule* targetHost = getSimulation()->getSystemModule()->getSubmodule("h", target.hostIdx);
+                cModule* targetApp = targetHost? targetHost->getSubmodule("udpApp", 0) : nullptr;
+
+                if(!targetApp)
                 {
-                    hasInput = true;
-                    std::cout << "input " << source << " is connected to actor " << name <<std::endl;
-                    inputs.push_back(source);
-                    weights.push_back(weight);
+                    std::cout << "no module found for actor " << target.name << " on host " << target.host << std::endl;
+                    exit(1);
                 }
-                else
-                {
-                    bool hasInitialToken = (chArr[i]["hasInitialToken"] != Json::Value::null);
-                    //std::cout << "producer " << source << ":" << port << ":" << buffers.size() << std::endl;
 
-                    buffers.push_back(new udpBuffer(chArr[i]["mem"].asUInt()));
-                    producers.push_back(new netInfo(source, actor2host[source], weight, port, hasInitialToken));
-                }
+                if(!links)
+                    links = &linkModel::get(par("linkModel").stdstringValue());
+
+                consumerGates.push_back(targetApp->gate("directIn"));
+                consumerLinks.push_back(&links->getLink(graph->getActor(actorId).hostIdx, target.hostIdx));
+                consumerHosts.push_back(target.hostIdx);
             }
         }
-}
-
-void    LinearActor::handleNodeCrash()
-{
-        std::cout << "actor " << name << " crashed!" << std::endl;
-}
 
-bool    LinearActor::handleNodeShutdown(inet::IDoneCallback *doneCallback)
-{
-        std::cout << "actor " << name << " shutdown." << std::endl;
-        return true;
-}
+        for(uint ch:graph->inputs(actorId))
+        {
+            auto& channel = graph->getChannel(ch);
 
-void    LinearActor::emulateSDFIteration()
-{
-        std::map<str2,double> oldVals = actorVals;
+            hasInput = true;
+            if(!quiet) { std::cout << "input i" << channel.input << " is connected to actor " << name <<std::endl; }
+            inputs.push_back(channel.input);
+            weights.push_back(channel.weight);
+        }
 
-        for(const auto& actor:exeOrder)
+        for(uint ch:graph->producers(actorId))
         {
-            double newVal = 0.0;
+            auto& channel = graph->getChannel(ch);
+            auto& source = graph->getActor(channel.source);
 
-            // look for sources of "actor" amongst channels
-            for(const auto& channel:channels)
-            {
-                auto target = channel["target"].asString();
-                auto source = channel["source"].asString();
-                auto weight = channel["weight"].asDouble();
+            //std::cout << "producer " << source.name << ":" << buffers.size() << std::endl;
+            buffers.push_back(new valBuffer(channel.mem, overflowPolicy));
 
-                if(weight == 0.0)
-                {
-                    std::cout << "ERROR: found weight of zero" << std::endl;
-                    exit(1);
-                }
+            /* one cell per slot, occupancy ranges from 0 to mem */
+            auto hist = new cHistogram(("channel " + source.name + " occupancy").c_str());
+            hist->setRange(0, channel.mem+1);
+            hist->setNumCells(channel.mem+1);
+            occupancy.push_back(hist);
 
-                bool hasTarget = (channel["target"] != Json::Value::null);                  // identify output channels
-                bool hasInitialToken = (channel["hasInitialToken"] != Json::Value::null);   // identify backedges
+            latency.push_back(new cHistogram(("channel " + source.name + " latency").c_str()));
+            slack.push_back(new cHistogram(("channel " + source.name + " slack").c_str()));
+            producers.push_back(new netInfo(source.name, source.host, channel.weight, graph->getActor(actorId).port, ch, channel.hasInitialToken));
+        }
+}
 
-                if(!hasTarget)
-                    continue;
+void    LinearActor::finish()
+{
+        ApplicationBase::finish();
 
-                if(target == actor)
-                {
-                    //std::cout << source << " -> " << target << std::endl;
+        /* buffer usage of each producer channel, to size "mem" by what the link needs */
+        for(uint i=0; i<buffers.size(); i++)
+        {
+            auto& stats = buffers[i]->getCounters();
+            str2 ch = "channel " + producers[i]->actor + " ";
+
+            recordScalar((ch + "mem").c_str(), buffers[i]->capacity());
+            recordScalar((ch + "highWater").c_str(), stats.highWater);
+            recordScalar((ch + "maxReorderDepth").c_str(), stats.maxReorder);
+            recordScalar((ch + "late").c_str(), stats.late);
+            recordScalar((ch + "dropped").c_str(), stats.dropped);
+            recordScalar((ch + "evicted").c_str(), stats.evicted);
+            recordScalar((ch + "grown").c_str(), stats.grown);
+            recordScalar((ch + "emptyTokens").c_str(), lostCount[i]);
+            recordScalar((ch + "lost").c_str(), stats.lost);
+
+            occupancy[i]->record();
+            latency[i]->record();
+            slack[i]->record();
+        }
 
-                    double srcVal = 0.0;
+        if(isOutput)
+        {
+            /* numIter or the target precision, whichever came first */
+            emit(snrSignal, pSignal/pNoise);
 
-                    if(source[0] == 'i')
-                        srcVal = sampleInput(source);
-                    else if(hasInitialToken)
-                        srcVal = oldVals[source];        /* for backedges, use values from previous iteration */
-                    else
-                        srcVal = actorVals[source];
+            if(!quiet) { std::cout << "pSignal:" << pSignal << ",pNoise:" << pNoise << std::endl; }
 
-                    newVal += weight * srcVal;
-                }
+            if(!quiet) { std::cout << "output," << name << ",SNR," << pSignal/pNoise << ",weight," << snrWeight << std::endl; }
+
+            recordScalar("iterations", iterCnt);
+
+            if(noiseCI)
+            {
+                recordScalar("noisePowerMean", noiseCI->mean());
+                recordScalar("noisePowerHalfWidth", noiseCI->halfWidth());
             }
 
-            actorVals[actor] = newVal;
+            recordScalar("pSignal", pSignal);
+            recordScalar("pNoise", pNoise);
+            recordScalar("snrWeight", snrWeight);
         }
 }
 
+void    LinearActor::handleNodeCrash()
+{
+        if(!quiet) { std::cout << "actor " << name << " crashed!" << std::endl; }
+}
+
+bool    LinearActor::handleNodeShutdown(inet::IDoneCallback *doneCallback)
+{
+        if(!quiet) { std::cout << "actor " << name << " shutdown." << std::endl; }
+        return true;
+}
+
 LinearActor::LinearActor()
-:       sinePeriod(1), sineBase(0.0), sineAmplitude(1.0),
-        iterCnt(0),
-        idle(true), hasInput(false), isOutput(false),
+:       iterCnt(0),
+        quiet(false), direct(false), idle(true), hasInput(false), isOutput(false), converged(false),
         snrWeight(1.0),
-        pSignal(0.0), pNoise(0.0),
+        pSignal(0.0), pNoise(0.0), targetPrecision(0.0),
         ts(0.0), wcet(0.0), period(0.0),
-        outVal(0.0), defaultVal(0.0)
+        outVal(0.0),
+        actorId(-1), selfMsg(nullptr), socket(nullptr), links(nullptr), streams(nullptr), myPolicy(nullptr), noiseCI(nullptr), reference(nullptr), graph(nullptr)
 {
         /* nothing to do */
 }
@@ -521,10 +580,16 @@ LinearActor::~LinearActor()
             if(selfMsg) { cancelEvent(selfMsg); }
             delete selfMsg;
 
-            for(sock* socket:inSockets)     delete socket;
-            for(sock* socket:outSockets)    delete socket;
+            delete socket;
+            delete streams;
+            delete myPolicy;
+            delete noiseCI;
+            for(tokenPacket* msg:tokenPool) delete msg;
             for(netInfo* prod:producers)    delete prod;
             for(netInfo* cons:consumers)    delete cons;
-            for(udpBuffer* buff:buffers)    delete buff;
+            for(valBuffer* buff:buffers)    delete buff;
+            for(cHistogram* hist:occupancy) delete hist;
+            for(cHistogram* hist:latency)   delete hist;
+            for(cHistogram* hist:slack)     delete hist;
         }
 }
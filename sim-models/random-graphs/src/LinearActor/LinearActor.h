@@ -17,52 +17,67 @@
 #define SCHEDSTREAM_LINEAR_ACTOR_H
 
 #include "../include/typedefs.h"
+#include "tokenPacket_m.h"
 
 class   INET_API LinearActor : public inet::ApplicationBase
 {
         private:
 
         enum        SelfMsgKinds { POP = 1, PUSH };
-        enum        ReplacementPolicy { AVG, LAST, STATIC };
 
         void        sendVal();
         void        setOutVal();
         void        printInfo();
-        void        printLoss();
         void        processStart();
         void        processPacket(cPacket *msg);
-        void        parseActors(Json::Value actorArr);
-        void        parseChannels(Json::Value chArr);
-        void        emulateSDFIteration();
-        double      genVal(arr<str2> inArr, arr<double> weightArr);
-        double      sampleInput(str2 inputName);
+        void        deliverToken(tokenPacket *pkt);
+        void        recycleToken(tokenPacket *msg);
+        tokenPacket*    newToken();
+        void        parseChannels();
+        double      genVal(arr<uint> inArr, arr<double> weightArr);
+        double      sampleInput(uint index);
+        bool        outputsConverged();
 
-        uint                    sinePeriod;
-        double                  sineBase, sineAmplitude;
+        sinusoid                sine;
 
         uint                    iterCnt;
         str2                    name, host;
-        bool                    idle, hasInput, isOutput;
+        bool                    quiet, direct, idle, hasInput, isOutput;
+        bool                    converged;              /* output reached the target precision */
         double                  snrWeight; // for output actors
         double                  pSignal, pNoise;
+        double                  targetPrecision;        /* relative half width of the noise power CI to stop at, 0 to run numIter */
         double                  ts, wcet, period;
-        double                  outVal, defaultVal;
-        strMap                  actor2host;
+        double                  outVal;
+        int                     actorId;
         cMessage*               selfMsg;
+        simsignal_t             outputErrorSignal, emptyTokenSignal, snrSignal;
         arr<uint>               lostCount;
-        arr<str2>               inputs, exeOrder;
-        arr<sock*>              inSockets, outSockets;
-        Json::Value             channels;               /* used for emulating SDF execution */
+        arr<uint>               inputs;
+        sock*                   socket;
+        arr<tokenPacket*>       tokenPool;              /* received tokens, reused for sending */
+        const linkModel*        links;                  /* delay and loss of each host pair, direct transport only */
+        arr<cGate*>             consumerGates;          /* "directIn" of each consumer, direct transport only */
+        arr<const linkModel::link*> consumerLinks;
+        arr<uint>               consumerHosts;          /* host index of each consumer, direct transport only */
+        omnetRng                rng;
+        linkStreams*            streams;                /* common random numbers per link and token, direct transport only */
         arr<double>             weights;
-        arr<double>             lastSeenVals, runningSums;
         arr<netInfo*>           producers, consumers;
-        arr<udpBuffer*>         buffers;
-        ReplacementPolicy       myPolicy;
-        std::map<str2,double>   actorVals;              /* used for emulating SDF execution */
+        arr<valBuffer*>         buffers;
+        arr<cHistogram*>        occupancy;              /* buffer occupancy of each producer channel */
+        arr<cHistogram*>        latency;                /* arrival minus send time of tokens, per producer channel */
+        arr<cHistogram*>        slack;                  /* arrival minus the time the token is consumed, per producer channel */
+        replacementPolicy*      myPolicy;               /* predicts values of empty tokens, one state per producer */
+        valBuffer::OverflowPolicy   overflowPolicy;
+        batchMeans*             noiseCI;                /* confidence interval of the noise power, output actors only */
+        const refSignal*        reference;              /* noiseless output, for output actors */
+        const tradfGraph*       graph;
 
         protected:
 
         virtual void    initialize(int stage) override;
+        virtual void    finish() override;
         virtual int     numInitStages() const override { return inet::NUM_INIT_STAGES; }
         virtual void    handleNodeCrash() override;
         virtual void    handleMessageWhenUp(cMessage *msg) override;
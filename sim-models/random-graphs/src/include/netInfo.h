@@ -1,7 +1,9 @@
 #ifndef SCHEDSTREAM_NET_INFO_H
 #define SCHEDSTREAM_NET_INFO_H
 
+#include <vector>
 #include <cstdlib>
+#include <iostream>
 #include <inet/networklayer/common/L3Address.h>
 //#include <inet/networklayer/common/L3AddressResolver.h>
 
@@ -9,8 +11,8 @@ class   netInfo
 {
         public:
 
-        netInfo(std::string _actor, std::string _host, double _weight, uint _port, bool _hasInitialToken)
-        : hasInitialToken(_hasInitialToken), port(_port), weight(_weight), actor(_actor), host(_host), addr(getIP(_host))
+        netInfo(std::string _actor, std::string _host, double _weight, uint _port, uint _channel, bool _hasInitialToken)
+        : hasInitialToken(_hasInitialToken), port(_port), channel(_channel), weight(_weight), actor(_actor), host(_host), addr(getIP(_host))
         {
                         /* nothing to do */
                         //std::cout << "created netInfo with port=" << port << " and host=" << host << std::endl;
@@ -25,10 +27,25 @@ class   netInfo
         }
 
         bool            hasInitialToken;
-        uint            port;
+        uint            port, channel;
         double          weight;
         std::string     actor, host;
         inet::L3Address addr;
 };
 
+inline void printActors(std::vector<netInfo*> arr)
+{
+        std::cout << "[";
+
+        for(unsigned int i=0; i<arr.size(); i++)
+        {
+            std::cout << arr[i]->actor;
+
+            if(i != arr.size()-1)
+                std::cout << ",";
+        }
+
+        std::cout << "]";
+}
+
 #endif
@@ -0,0 +1,165 @@
+#ifndef SCHEDSTREAM_PREDICTORS_H
+#define SCHEDSTREAM_PREDICTORS_H
+
+#include <string>
+#include <vector>
+
+/*
+    Replacement policies for empty tokens.
+
+    Each policy is a small state kept per producer channel: observe() is called with every value
+    that arrived (or initial token), predict() replaces a value that did not arrive. The policy is
+    picked once per actor and all of its channels are kept in one bank, so choosing the policy costs
+    one virtual call per token and the update itself is inlined.
+*/
+
+struct  predictorParams
+{
+        double          defaultVal;         // static
+        double          alpha;              // ewma, weight of the newest value
+        double          q, r;               // kalman, process and measurement noise
+};
+
+namespace   predictors
+{
+        /* always the same value */
+        struct  staticValue
+        {
+                double          val;
+
+                staticValue(const predictorParams& p) : val(p.defaultVal) {}
+
+                void            observe(double)     {}
+                double          predict()           { return val; }
+        };
+
+        /* last value that arrived, zero before the first one */
+        struct  lastSeen
+        {
+                double          last;
+
+                lastSeen(const predictorParams&) : last(0.0) {}
+
+                void            observe(double v)   { last = v; }
+                double          predict()           { return last; }
+        };
+
+        /* mean of all values that arrived, updated incrementally */
+        struct  runningAverage
+        {
+                double          mean;
+                unsigned long   count;
+
+                runningAverage(const predictorParams&) : mean(0.0), count(0) {}
+
+                void            observe(double v)   { count++; mean += (v-mean)/count; }
+                double          predict()           { return mean; }
+        };
+
+        /* exponentially weighted moving average */
+        struct  ewma
+        {
+                double          alpha, avg;
+                bool            seen;
+
+                ewma(const predictorParams& p) : alpha(p.alpha), avg(0.0), seen(false) {}
+
+                void            observe(double v)   { avg = seen? (alpha*v + (1.0-alpha)*avg) : v; seen = true; }
+                double          predict()           { return avg; }
+        };
+
+        /* continues the line through the last two values, predictions count as values */
+        struct  linear
+        {
+                double          last, prev;
+                unsigned int    count;
+
+                linear(const predictorParams&) : last(0.0), prev(0.0), count(0) {}
+
+                void            observe(double v)   { prev = last; last = v; if(count < 2) count++; }
+                double          predict()
+                {
+                                if(count < 2)
+                                    return last;
+
+                                double v = last + (last-prev);
+                                observe(v);
+                                return v;
+                }
+        };
+
+        /* scalar Kalman filter for a random walk, missing values only grow the uncertainty */
+        struct  kalman
+        {
+                double          q, r, x, p;
+                bool            seen;
+
+                kalman(const predictorParams& params) : q(params.q), r(params.r), x(0.0), p(0.0), seen(false) {}
+
+                void            observe(double z)
+                {
+                                if(!seen)
+                                {
+                                    x = z;
+                                    p = r;
+                                    seen = true;
+                                    return;
+                                }
+
+                                p += q;
+                                double k = p/(p+r);
+                                x += k*(z-x);
+                                p *= (1.0-k);
+                }
+
+                double          predict()
+                {
+                                if(seen)
+                                    p += q;
+
+                                return x;
+                }
+        };
+}
+
+class   replacementPolicy
+{
+        public:
+
+        virtual         ~replacementPolicy() {}
+
+        virtual void    observe(unsigned int channel, double val) = 0;
+        virtual double  predict(unsigned int channel) = 0;
+
+        /* policy by the name used in .ini files, nullptr if the name is unknown */
+        static  replacementPolicy*  create(const std::string& name, unsigned int channels, const predictorParams& p);
+};
+
+template<class S>
+class   policyBank : public replacementPolicy
+{
+        public:
+
+        policyBank(unsigned int channels, const predictorParams& p) : states(channels, S(p)) {}
+
+        virtual void    observe(unsigned int channel, double val) override  { states[channel].observe(val); }
+        virtual double  predict(unsigned int channel) override              { return states[channel].predict(); }
+
+        private:
+
+        std::vector<S>  states;
+};
+
+inline  replacementPolicy*  replacementPolicy::create(const std::string& name, unsigned int channels, const predictorParams& p)
+{
+        if( name == "static" )          { return new policyBank<predictors::staticValue>(channels, p); }
+        if( name == "lastSeen" )        { return new policyBank<predictors::lastSeen>(channels, p); }
+        if( name == "runningAverage" )  { return new policyBank<predictors::runningAverage>(channels, p); }
+        if( name == "ewma" )            { return new policyBank<predictors::ewma>(channels, p); }
+        if( name == "linear" )          { return new policyBank<predictors::linear>(channels, p); }
+        if( name == "kalman" )          { return new policyBank<predictors::kalman>(channels, p); }
+
+        return nullptr;
+}
+
+#endif
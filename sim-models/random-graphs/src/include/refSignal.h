@@ -0,0 +1,118 @@
+#ifndef SCHEDSTREAM_REF_SIGNAL_H
+#define SCHEDSTREAM_REF_SIGNAL_H
+
+#include <map>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <tuple>
+#include "sdfKernel.h"
+#include "tradfGraph.h"
+
+/* input "index" of the graph at iteration "iter", phase is reduced first so that samples repeat exactly */
+struct  sinusoid
+{
+        unsigned int    period;
+        double          base, amplitude;
+
+        double          sample(unsigned int index, unsigned int iter) const
+        {
+                        return base + (amplitude * sin((2*M_PI*((iter+index)%period))/period));
+        }
+};
+
+/*
+    Noiseless output of every output actor, shared by all of them.
+
+    The graph is LTI and its inputs repeat every "period" iterations, so once the state of the graph
+    repeats after one period the outputs are periodic from then on. The trace is emulated up to that
+    point (or up to "numIter" if it comes first) and later iterations are folded back onto the last
+    period.
+*/
+
+class   refSignal
+{
+        public:
+
+        static  const refSignal&    get(const tradfGraph& graph, const sinusoid& sine, unsigned int numIter)
+        {
+                    static std::map<std::tuple<const tradfGraph*,unsigned int,double,double,unsigned int>,std::unique_ptr<refSignal>> registry;
+
+                    auto& entry = registry[std::make_tuple(&graph,sine.period,sine.base,sine.amplitude,numIter)];
+
+                    if(!entry)
+                        entry.reset(new refSignal(graph, sine, numIter));
+
+                    return *entry;
+        }
+
+        double      value(unsigned int actor, unsigned int iter) const
+        {
+                    if(iter >= length)
+                        iter = periodStart + ((iter-periodStart) % period);
+
+                    return trace[(iter*outputs.size()) + slot[actor]];
+        }
+
+        /* number of emulated iterations */
+        unsigned int    size()  const   { return length; }
+
+        private:
+
+        refSignal(const tradfGraph& graph, const sinusoid& sine, unsigned int numIter)
+        : length(0), periodStart(0), period(sine.period), slot(graph.actorCount(), -1)
+        {
+                    sdfKernel kernel(graph);
+                    std::vector<double> inputVals(graph.inputCount());
+                    std::vector<double> state(graph.actorCount()), snapshot(graph.actorCount(), 0.0);
+
+                    for(unsigned int id=0; id<graph.actorCount(); id++)
+                    {
+                        if(graph.outputChannel(id) >= 0)
+                        {
+                            slot[id] = outputs.size();
+                            outputs.push_back(id);
+                        }
+                    }
+
+                    while(length < numIter)
+                    {
+                        for(unsigned int i=0; i<inputVals.size(); i++)
+                            inputVals[i] = sine.sample(i, length);
+
+                        kernel.iterate(inputVals.data());
+
+                        for(unsigned int id:outputs)
+                            trace.push_back(kernel.value(id));
+
+                        length++;
+
+                        if((length % period) == 0)
+                        {
+                            bool repeats = true;
+
+                            for(unsigned int id=0; id<graph.actorCount(); id++)
+                            {
+                                state[id] = kernel.value(id);
+                                repeats = repeats && (state[id] == snapshot[id]);
+                            }
+
+                            /* state after this iteration equals the one a period ago (zero before the first one) */
+                            if(repeats)
+                            {
+                                periodStart = length-period;
+                                break;
+                            }
+
+                            snapshot.swap(state);
+                        }
+                    }
+        }
+
+        unsigned int                length, periodStart, period;
+        std::vector<int>            slot;
+        std::vector<double>         trace;
+        std::vector<unsigned int>   outputs;
+};
+
+#endif
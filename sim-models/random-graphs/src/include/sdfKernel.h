@@ -0,0 +1,115 @@
+#ifndef SCHEDSTREAM_SDF_KERNEL_H
+#define SCHEDSTREAM_SDF_KERNEL_H
+
+#include <vector>
+#include <climits>
+#include <utility>
+#include <iostream>
+#include "tradfGraph.h"
+
+/*
+    Noiseless SDF execution of a T-RADF graph, compiled to CSR form.
+
+    Row r of the matrix computes the actor at position r of the execution order. Each non-zero keeps
+    the channel weight, the index of its source and which vector the source is read from:
+      - CUR   : actors that already fired in this iteration
+      - PREV  : backedges, and actors that fire later in the execution order
+      - INPUT : graph inputs sampled for this iteration
+    Non-zeros keep the order of "channels" so sums are accumulated exactly as before.
+*/
+
+class   sdfKernel
+{
+        public:
+
+        sdfKernel(const tradfGraph& graph)
+        : cur(graph.actorCount(), 0.0), prev(graph.actorCount(), 0.0)
+        {
+                    auto& order = graph.executionOrder();
+                    std::vector<unsigned int> pos(graph.actorCount(), UINT_MAX);
+
+                    for(unsigned int r=0; r<order.size(); r++)
+                        pos[order[r]] = r;
+
+                    for(unsigned int ch=0; ch<graph.channelCount(); ch++)
+                    {
+                        if(graph.getChannel(ch).weight == 0.0)
+                        {
+                            std::cout << "ERROR: found weight of zero" << std::endl;
+                            exit(1);
+                        }
+                    }
+
+                    rowOffsets.push_back(0);
+
+                    for(unsigned int actor:order)
+                    {
+                        auto in = graph.inputs(actor);
+                        auto prod = graph.producers(actor);
+                        auto i = in.begin();
+                        auto p = prod.begin();
+
+                        /* merge both rows so that non-zeros follow channel order */
+                        while((i != in.end()) || (p != prod.end()))
+                        {
+                            if((p == prod.end()) || ((i != in.end()) && (*i < *p)))
+                            {
+                                auto& channel = graph.getChannel(*i++);
+
+                                add(INPUT, channel.input, channel.weight);
+                            }
+                            else
+                            {
+                                auto& channel = graph.getChannel(*p++);
+
+                                if(channel.hasInitialToken || (pos[channel.source] >= pos[actor]))
+                                    add(PREV, channel.source, channel.weight);
+                                else
+                                    add(CUR, channel.source, channel.weight);
+                            }
+                        }
+
+                        rowActors.push_back(actor);
+                        rowOffsets.push_back(weights.size());
+                    }
+        }
+
+        /* fires every actor once, "inputVals" holds the samples of graph inputs for this iteration */
+        void        iterate(const double* inputVals)
+        {
+                    std::swap(cur, prev);
+
+                    const double* base[3] = { cur.data(), prev.data(), inputVals };
+
+                    for(unsigned int r=0; r<rowActors.size(); r++)
+                    {
+                        double val = 0.0;
+
+                        for(unsigned int e=rowOffsets[r]; e<rowOffsets[r+1]; e++)
+                            val += weights[e] * base[kinds[e]][cols[e]];
+
+                        cur[rowActors[r]] = val;
+                    }
+        }
+
+        double      value(unsigned int actor) const { return cur[actor]; }
+
+        private:
+
+        enum        SourceKind { CUR = 0, PREV, INPUT };
+
+        void        add(SourceKind kind, unsigned int col, double weight)
+        {
+                    kinds.push_back(kind);
+                    cols.push_back(col);
+                    weights.push_back(weight);
+        }
+
+        std::vector<double>         cur, prev;
+        std::vector<double>         weights;
+        std::vector<unsigned int>   cols;
+        std::vector<unsigned char>  kinds;
+        std::vector<unsigned int>   rowOffsets, rowActors;
+};
+
+#endif
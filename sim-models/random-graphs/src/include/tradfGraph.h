@@ -0,0 +1,257 @@
+#ifndef SCHEDSTREAM_TRADF_GRAPH_H
+#define SCHEDSTREAM_TRADF_GRAPH_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <jsoncpp/json/json.h>
+#include "utility.h"
+
+#define ACTOR_BASE_PORTNUM  11000
+
+/*
+    Read-only view of a scheduled T-RADF graph, parsed once per process and shared by all actors.
+
+    - actors are interned to dense ids in the order they appear in "actors", which also fixes the
+      port they receive tokens on (ACTOR_BASE_PORTNUM+id)
+    - channels keep their index in "channels"
+    - incoming actor channels, incoming input channels and outgoing channels of each actor are kept
+      in CSR form (offsets into one flat array of channel indices per relation), in file order
+*/
+
+class   tradfGraph
+{
+        public:
+
+        struct  actor
+        {
+                std::string     name, host;
+                unsigned int    hostIdx, port;
+                double          ts, wcet;
+        };
+
+        struct  channel
+        {
+                int             source, target;     // actor ids, -1 for graph inputs/outputs
+                unsigned int    input;              // index of graph input, only valid if source == -1
+                unsigned int    slot;               // position among producers of target, only valid if both are actors
+                unsigned int    mem;
+                bool            hasInitialToken;
+                double          weight;
+        };
+
+        /* CSR row, i.e. channel indices of one actor */
+        struct  row
+        {
+                const unsigned int* first;
+                const unsigned int* last;
+
+                const unsigned int* begin()     const   { return first; }
+                const unsigned int* end()       const   { return last; }
+                unsigned int        size()      const   { return (last-first); }
+        };
+
+        static  const tradfGraph&   get(const std::string& path2graph)
+        {
+                    static std::map<std::string,std::unique_ptr<tradfGraph>> registry;
+
+                    auto& entry = registry[path2graph];
+
+                    if(!entry)
+                        entry.reset(new tradfGraph(path2graph));
+
+                    return *entry;
+        }
+
+        int                 actorId(const std::string& name) const
+        {
+                    auto it = name2id.find(name);
+                    return (it == name2id.end())? -1 : (int)it->second;
+        }
+
+        unsigned int        actorCount()    const   { return actors.size(); }
+        unsigned int        channelCount()  const   { return channels.size(); }
+        unsigned int        inputCount()    const   { return numInputs; }
+        unsigned int        hostCount()     const   { return numHosts; }
+        double              getPeriod()     const   { return period; }
+
+        const actor&        getActor(unsigned int id)   const   { return actors[id]; }
+        const channel&      getChannel(unsigned int ch) const   { return channels[ch]; }
+
+        /* actors in "executionOrder", used for emulating SDF execution */
+        const std::vector<unsigned int>&    executionOrder()    const   { return exeOrder; }
+
+        row                 producers(unsigned int id)  const   { return getRow(prodOffsets, prodChannels, id); }
+        row                 consumers(unsigned int id)  const   { return getRow(consOffsets, consChannels, id); }
+        row                 inputs(unsigned int id)     const   { return getRow(inOffsets, inChannels, id); }
+
+        /* iteration of the target that consumes token "seqN" of channel "ch", the initial token of a backedge is consumed in iteration 0 */
+        unsigned int        consumingIteration(unsigned int ch, unsigned int seqN)  const
+        {
+                    return seqN + (channels[ch].hasInitialToken? 1 : 0);
+        }
+
+        /* channel without target that is fed by the actor, -1 if actor is not an output */
+        int                 outputChannel(unsigned int id)  const   { return outChannel[id]; }
+
+        private:
+
+        tradfGraph(const std::string& path2graph)
+        : numInputs(0), numHosts(0), period(0.0)
+        {
+                    Json::Value obj;
+                    std::ifstream cfg(path2graph.c_str(), std::ifstream::binary);
+
+                    if(!cfg.is_open())
+                    {
+                        std::cout << "Unable to open file " << path2graph << std::endl;
+                        exit(3);
+                    }
+
+                    cfg >> obj;
+
+                    period = conv2sec(obj["period"].asString());
+
+                    parseActors(obj["actors"]);
+                    parseChannels(obj["channels"]);
+
+                    for(const auto& actorName:obj["executionOrder"])
+                    {
+                        int id = actorId(actorName.asString());
+
+                        if(id < 0)
+                        {
+                            std::cout << "unknown actor " << actorName.asString() << " in execution order" << std::endl;
+                            exit(1);
+                        }
+
+                        exeOrder.push_back(id);
+                    }
+        }
+
+        void                parseActors(const Json::Value& actorArr)
+        {
+                    for(const auto& a:actorArr)
+                    {
+                        actor info;
+
+                        info.name = a["name"].asString();
+                        info.host = a["host"].asString();
+                        info.hostIdx = std::stoi(info.host.substr(1));
+                        info.port = ACTOR_BASE_PORTNUM+actors.size();
+                        info.ts = conv2sec(a["ts"].asString());
+                        info.wcet = conv2sec(a["wcet"].asString());
+
+                        if(info.hostIdx >= numHosts)
+                            numHosts = info.hostIdx+1;
+
+                        name2id[info.name] = actors.size();
+                        actors.push_back(info);
+                    }
+        }
+
+        void                parseChannels(const Json::Value& chArr)
+        {
+                    std::vector<std::vector<unsigned int>> prod(actors.size()), cons(actors.size()), in(actors.size());
+
+                    outChannel.assign(actors.size(), -1);
+
+                    for(unsigned int i=0; i<chArr.size(); i++)
+                    {
+                        channel ch;
+                        auto source = chArr[i]["source"].asString();
+
+                        ch.weight = chArr[i]["weight"].asDouble();
+                        ch.mem = chArr[i]["mem"].asUInt();
+                        ch.hasInitialToken = (chArr[i]["hasInitialToken"] != Json::Value::null);
+                        ch.input = 0;
+                        ch.slot = 0;
+                        ch.source = -1;
+                        ch.target = -1;
+
+                        if(chArr[i]["target"] != Json::Value::null)
+                            ch.target = lookup(chArr[i]["target"].asString());
+
+                        if(source[0] == 'i')
+                        {
+                            ch.input = atoi(source.substr(1).c_str());
+
+                            if(ch.input >= numInputs)
+                                numInputs = ch.input+1;
+                        }
+                        else
+                        {
+                            ch.source = lookup(source);
+                        }
+
+                        if(ch.target >= 0)
+                        {
+                            if(ch.source >= 0)
+                            {
+                                ch.slot = prod[ch.target].size();
+                                prod[ch.target].push_back(i);
+                                cons[ch.source].push_back(i);
+                            }
+                            else
+                            {
+                                in[ch.target].push_back(i);
+                            }
+                        }
+                        else if(ch.source >= 0)
+                        {
+                            outChannel[ch.source] = i;
+                        }
+
+                        channels.push_back(ch);
+                    }
+
+                    flatten(prod, prodOffsets, prodChannels);
+                    flatten(cons, consOffsets, consChannels);
+                    flatten(in, inOffsets, inChannels);
+        }
+
+        int                 lookup(const std::string& name) const
+        {
+                    int id = actorId(name);
+
+                    if(id < 0)
+                    {
+                        std::cout << "channel refers to unknown actor " << name << std::endl;
+                        exit(1);
+                    }
+
+                    return id;
+        }
+
+        static  void        flatten(const std::vector<std::vector<unsigned int>>& lists, std::vector<unsigned int>& offsets, std::vector<unsigned int>& flat)
+        {
+                    offsets.push_back(0);
+
+                    for(const auto& list:lists)
+                    {
+                        flat.insert(flat.end(), list.begin(), list.end());
+                        offsets.push_back(flat.size());
+                    }
+        }
+
+        static  row         getRow(const std::vector<unsigned int>& offsets, const std::vector<unsigned int>& flat, unsigned int id)
+        {
+                    return row{ flat.data()+offsets[id], flat.data()+offsets[id+1] };
+        }
+
+        unsigned int                        numInputs, numHosts;
+        double                              period;
+        std::vector<actor>                  actors;
+        std::vector<channel>                channels;
+        std::vector<unsigned int>           exeOrder;
+        std::vector<int>                    outChannel;
+        std::vector<unsigned int>           prodOffsets, prodChannels;
+        std::vector<unsigned int>           consOffsets, consChannels;
+        std::vector<unsigned int>           inOffsets, inChannels;
+        std::map<std::string,unsigned int>  name2id;
+};
+
+#endif
@@ -4,8 +4,12 @@
 #include <map>
 #include <vector>
 #include "netInfo.h"
-#include "udpBuffer.h"
-#include <jsoncpp/json/json.h>
+#include "../../../common/udpBuffer.h"
+#include "../../../common/batchMeans.h"
+#include "refSignal.h"
+#include "predictors.h"
+#include "tradfGraph.h"
+#include "../../../common/linkStreams.h"
 #include <inet/applications/base/ApplicationBase.h>
 #include <inet/transportlayer/contract/udp/UDPSocket.h>
 
@@ -17,5 +21,14 @@ using   uint = unsigned int;
 using   sock = inet::UDPSocket;
 using   strMap = std::map<str2,str2>;
 using   addrMap = std::map<str2,inet::L3Address>;
+using   valBuffer = udpBuffer<double>;
+
+/* uniform numbers for linkModel, drawn from an RNG of the module */
+struct  omnetRng
+{
+        omnetpp::cRNG*  rng;
+
+        double          uniform01()     { return rng->doubleRandNonz(); }
+};
 
 #endif
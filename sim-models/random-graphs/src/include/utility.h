@@ -1,9 +1,14 @@
 #ifndef SCHEDSTREAM_UTILITY_H
 #define SCHEDSTREAM_UTILITY_H
 
-double  conv2sec(std::string val)
+#include <string>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+
+inline double conv2sec(std::string val)
 {
-        float number;
+        float number = 0;
         std::string unit = "none";
 
         for(unsigned int i=0; i<val.length(); i++)
@@ -33,36 +38,4 @@ double  conv2sec(std::string val)
         }
 }
 
-void    printActors(std::vector<netInfo*> arr)
-{
-        std::cout << "[";
-
-        for(unsigned int i=0; i<arr.size(); i++)
-        {
-            std::cout << arr[i]->actor;
-
-            if(i != arr.size()-1)
-                std::cout << ",";
-        }
-
-        std::cout << "]";
-}
-
-void    printPorts(std::vector<netInfo*> arr)
-{
-        std::cout << "[";
-
-        for(unsigned int i=0; i<arr.size(); i++)
-        {
-            std::cout << arr[i]->port;
-
-            if(i != arr.size()-1)
-                std::cout << ",";
-        }
-
-        std::cout << "]";
-}
-
-
-
 #endif
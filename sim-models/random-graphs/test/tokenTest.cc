@@ -0,0 +1,240 @@
+//
+// Checks of the token bookkeeping of LinearActor that do not need OMNeT++:
+//  - every token of a channel is consumed in the iteration graph->consumingIteration() gives,
+//    which is what the recorded slack is measured against, checked against replications of the
+//    evaluator's model (sim-models/evaluator/graphSim.h) on a graph with backedges
+//  - the buffer counts a token as lost exactly if it had not arrived when it was consumed,
+//    under every overflow policy
+//
+// usage: tokenTest [scheduled T-RADF graph with initial tokens] [network description]
+//
+
+#include <set>
+#include <map>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <fstream>
+#include <unistd.h>
+#include "../src/include/tradfGraph.h"
+#include "../../common/udpBuffer.h"
+#include "../../evaluator/graphSim.h"
+
+#define ITERATIONS      50
+#define REPLICATIONS    20
+
+/* token as delivered by the network, see tokenPacket.msg */
+struct  testToken
+{
+        unsigned int    seqN;
+        double          val;
+
+        unsigned int    getSequenceNumber() const   { return seqN; }
+        const double&   getPayload()        const   { return val; }
+};
+
+static  int     failures = 0;
+
+static  void    check(bool cond, const std::string& what)
+{
+        if(!cond)
+        {
+            std::cout << "FAILED: " << what << std::endl;
+            failures++;
+        }
+}
+
+/* copy of a network description with every delay stretched by "factor", in a temporary file */
+static  std::string     stretchedNetwork(const std::string& path2net, double factor)
+{
+        Json::Value net;
+        std::ifstream in(path2net);
+        char fn[] = "/tmp/tokenTest.XXXXXX";
+        int fd = mkstemp(fn);
+
+        in >> net;
+
+        for(auto& src:net.getMemberNames())
+        {
+            for(auto& dst:net[src].getMemberNames())
+            {
+                Json::Value& l = net[src][dst];
+
+                l["loc"] = l["loc"].asDouble()*factor;
+                l["scale"] = l["scale"].asDouble()*factor;
+            }
+        }
+
+        if(fd < 0)
+        {
+            std::cout << "Unable to create a temporary file" << std::endl;
+            exit(1);
+        }
+
+        close(fd);
+        std::ofstream out(fn);
+        out << net;
+
+        return fn;
+}
+
+/* arrival time and consuming iteration of every token of a replication, by (channel, sequence number) */
+struct  tokenLog : public graphSim::observer
+{
+        std::map<std::pair<unsigned int,unsigned int>,double>       arrivals;
+        std::map<std::pair<unsigned int,unsigned int>,unsigned int> consumers;
+
+        void    arrived(double now, unsigned int ch, unsigned int seqN) override
+        {
+                arrivals[std::make_pair(ch, seqN)] = now;
+        }
+
+        void    consumed(double now, unsigned int ch, unsigned int seqN, unsigned int iter) override
+        {
+                consumers[std::make_pair(ch, seqN)] = iter;
+        }
+};
+
+/*
+    Replays the graph with the evaluator's model of LinearActor and compares graph->consumingIteration() with the iteration that actually read each
+    token. A token that arrives before the target reads in that iteration has to be consumed then,
+    a later one never. GROW keeps overflow out of the way. Delays are stretched to a few tenths of
+    a period, so tokens of a channel overtake each other and many miss their iteration, the links
+    also lose some.
+*/
+static  void    testConsumingIteration(const tradfGraph& graph, const std::string& path2net)
+{
+        std::string path2stretched = stretchedNetwork(path2net, 0.1*graph.getPeriod()*1000.0);
+        const linkModel& links = linkModel::get(path2stretched);
+        unlink(path2stretched.c_str());
+
+        simParams params;
+
+        params.numIter = ITERATIONS;
+        params.policy = "static";
+        params.overflowPolicy = udpBuffer<double>::GROW;
+        params.predictor = predictorParams{ 0.0, 0.5, 1.0, 1.0 };
+        params.sine = sinusoid{ 10, 2.0, 5.0 };
+
+        const refSignal& reference = refSignal::get(graph, params.sine, params.numIter);
+        unsigned long consumed = 0, backedgeTokens = 0, reordered = 0, lost = 0, late = 0;
+
+        for(uint32_t seed=0; seed<REPLICATIONS; seed++)
+        {
+            graphSim sim(graph, links, reference, params, seed);
+            tokenLog log;
+
+            sim.setObserver(&log);
+            sim.run();
+
+            for(auto& c:log.consumers)
+            {
+                unsigned int ch = c.first.first, seqN = c.first.second;
+
+                check(graph.consumingIteration(ch, seqN) == c.second, "token " + std::to_string(seqN) + " of channel " + std::to_string(ch) + " consumed in iteration " + std::to_string(c.second));
+                consumed++;
+
+                if(graph.getChannel(ch).hasInitialToken)
+                    backedgeTokens++;
+            }
+
+            for(unsigned int ch=0; ch<graph.channelCount(); ch++)
+            {
+                const tradfGraph::channel& channel = graph.getChannel(ch);
+                double last = -1.0;
+
+                // output actors do not send to their consumers, in LinearActor neither
+                if((channel.source < 0) || (channel.target < 0) || (graph.outputChannel(channel.source) >= 0))
+                    continue;
+
+                for(unsigned int seqN=0; seqN<params.numIter; seqN++)
+                {
+                    auto key = std::make_pair(ch, seqN);
+                    auto it = log.arrivals.find(key);
+
+                    if(it == log.arrivals.end())
+                    {
+                        lost++;
+                        check(!log.consumers.count(key), "lost token " + std::to_string(seqN) + " of channel " + std::to_string(ch) + " was consumed");
+                        continue;
+                    }
+
+                    reordered += (it->second < last)? 1 : 0;
+                    last = std::max(last, it->second);
+
+                    unsigned int iter = graph.consumingIteration(ch, seqN);
+                    double readTime = graph.getActor(channel.target).ts + (iter*graph.getPeriod());
+
+                    // the run ends after numIter iterations, and ties depend on rounding of the event times
+                    if((iter >= params.numIter) || (fabs(it->second - readTime) < 1e-9))
+                        continue;
+
+                    late += (it->second > readTime)? 1 : 0;
+                    check((it->second < readTime) == (log.consumers.count(key) > 0), "token " + std::to_string(seqN) + " of channel " + std::to_string(ch) + " arrived at " + std::to_string(it->second) + ", read at " + std::to_string(readTime));
+                }
+            }
+        }
+
+        check(backedgeTokens > 0, "no token of a channel with an initial token was consumed");
+        check((reordered > 0) && (lost > 0) && (late > 0), "the replay has no reordered, lost or late tokens");
+        std::cout << "consumingIteration: " << consumed << " tokens consumed (" << backedgeTokens << " on backedges), " << reordered << " reordered, " << lost << " lost, " << late << " late" << std::endl;
+}
+
+/* random arrivals around the iteration being read, some tokens are never sent and some are sent after their iteration */
+static  void    testLostCount()
+{
+        const char* names[] = { "dropNewest", "dropOldest", "grow" };
+
+        for(unsigned int p=0; p<3; p++)
+        {
+            udpBuffer<double> buffer(4, (udpBuffer<double>::OverflowPolicy)p);
+            std::mt19937 rng(p);
+            std::set<unsigned int> arrived;         // tokens sent so far
+            unsigned long lost = 0, empty = 0;
+
+            for(unsigned int iter=0; iter<10*ITERATIONS; iter++)
+            {
+                for(unsigned int n=rng()%3; n>0; n--)
+                {
+                    unsigned int seqN = iter + (rng()%8);
+
+                    if((seqN >= 2) && (rng()%4 == 0))
+                        seqN -= 2;
+
+                    if(arrived.insert(seqN).second)
+                    {
+                        testToken tk = { seqN, (double)seqN };
+                        buffer.addToken(&tk);
+                    }
+                }
+
+                if(buffer.readToken().isEmpty())
+                {
+                    empty++;
+
+                    if(!arrived.count(iter))
+                        lost++;
+                }
+
+                buffer.popToken();
+            }
+
+            check(buffer.getCounters().lost == lost, std::string(names[p]) + ": " + std::to_string(buffer.getCounters().lost) + " tokens counted lost, " + std::to_string(lost) + " expected");
+            std::cout << "lost count (" << names[p] << "): " << lost << " lost, " << empty-lost << " overflowed" << std::endl;
+        }
+}
+
+int     main(int argc, char** argv)
+{
+        if(argc != 3)
+        {
+            std::cout << "usage: " << argv[0] << " [scheduled T-RADF graph with initial tokens] [network description]" << std::endl;
+            return 1;
+        }
+
+        testConsumingIteration(tradfGraph::get(argv[1]), argv[2]);
+        testLostCount();
+
+        std::cout << ((failures == 0)? "all tests passed" : "tests failed") << std::endl;
+        return (failures == 0)? 0 : 1;
+}